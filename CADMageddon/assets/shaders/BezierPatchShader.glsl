@@ -121,10 +121,13 @@ void main ()
 #version 440 core
 
 layout(location = 0) out vec4 color;
+//only written to a buffer in the picking pass
+layout(location = 1) out uint id;
 
 in vec2 tess_TextureCoordinates;
 
 uniform vec4 u_Color;
+uniform int u_Id;
 uniform bool isTrimmed;
 uniform bool reverseTrimming;
 
@@ -147,4 +150,5 @@ void main()
     }
 
     color = vec4(u_Color.xyz,1.0f);
+    id = uint(u_Id);
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ void main()
 #type geometry
 #version 440 core
 layout( lines_adjacency ) in;
+//only the position is emitted, 256 vertices of 4 components fill the guaranteed 1024 total, the color is a uniform
 layout( line_strip, max_vertices=256 ) out;
 
 
@@ -59,10 +60,14 @@ void main( )
 #version 440 core
 
 layout(location = 0) out vec4 color;
+//only written to a buffer in the picking pass
+layout(location = 1) out uint id;
 
 uniform vec4 u_Color;
+uniform int u_Id;
 
 void main()
 {
     color = u_Color;
+    id = uint(u_Id);
 }
@@ -1,23 +1,69 @@
-//Cubic Bezier
+//Gregory Patch
 
 #type vertex
 #version 440 core
 
-layout (location =0) in float a_Position;
+layout (location =0) in vec3 a_Position;
+
+flat out int v_InstanceId;
 
 void main()
 {
-    gl_Position = vec4(a_Position,0.0f,0.0f, 1.0f);
+    v_InstanceId = gl_InstanceID;
+    gl_Position = vec4(a_Position, 1.0f);
 }
 
-#type geometry
+#type tessControl
 #version 440 core
-layout( points ) in;
-layout( line_strip, max_vertices=256 ) out;
+layout (vertices = 20) out;
+
+flat in int v_InstanceId[];
+
+//even instances draw lines of constant v, odd instances lines of constant u
+//each line is split into u_ChunkCount instances so it can use more than gl_MaxTessGenLevel segments
+patch out int tc_Direction;
+patch out int tc_Chunk;
 
-uniform vec3 gregoryPoints[20];
-uniform bool isForward;
 uniform mat4 u_ViewProjectionMatrix;
+uniform int u_UDivisionCount;
+uniform int u_VDivisionCount;
+uniform int u_ChunkCount;
+
+vec2 ScreenPosition(int index)
+{
+    vec4 position = u_ViewProjectionMatrix * vec4(gl_in[index].gl_Position.xyz, 1.0f);
+    return position.xy / position.w;
+}
+
+void main()
+{
+    gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;
+
+    if (gl_InvocationID == 0)
+    {
+        tc_Direction = v_InstanceId[0] % 2;
+        tc_Chunk = v_InstanceId[0] / 2;
+
+        vec2 corner0 = ScreenPosition(0);
+        vec2 corner1 = ScreenPosition(5);
+        vec2 corner2 = ScreenPosition(10);
+        vec2 corner3 = ScreenPosition(15);
+        float dist = distance(corner0, corner1) + distance(corner1, corner2) + distance(corner2, corner3) + distance(corner3, corner0);
+
+        gl_TessLevelOuter[0] = tc_Direction == 0 ? u_UDivisionCount : u_VDivisionCount;
+        gl_TessLevelOuter[1] = clamp(dist * 20.0f / u_ChunkCount + 1.0f, 1.0f, float(gl_MaxTessGenLevel));
+    }
+}
+
+#type tessEval
+#version 440 core
+layout (isolines, equal_spacing, cw) in;
+
+patch in int tc_Direction;
+patch in int tc_Chunk;
+
+uniform mat4 u_ViewProjectionMatrix;
+uniform int u_ChunkCount;
 
 vec4 BernsteinBasis(float t)
 {
@@ -29,74 +75,55 @@ vec4 BernsteinBasis(float t)
                    t * t * t );
 }
 
+vec3 GregoryPoint(int index)
+{
+    return gl_in[index].gl_Position.xyz;
+}
+
+//inner points blend the two twist points, the denominators vanish only on borders where the weight is zero anyway
+vec3 InnerPoint(float a, vec3 first, float b, vec3 second)
+{
+    return (a * first + b * second) / max(a + b, 1e-6f);
+}
+
 void main()
 {
+    //isolines generate lines at 0, 1/n, ..., (n-1)/n, stretch them so the last one lies on the border
+    float lineCount = gl_TessLevelOuter[0];
+    float line = gl_TessCoord.y * lineCount / max(lineCount - 1.0f, 1.0f);
+    float along = (tc_Chunk + gl_TessCoord.x) / u_ChunkCount;
 
-    float x = gl_in[0].gl_Position.x, u, v;
-    vec4 uCoord, vCoord;// = toBernstein3(u);
-    if (isForward) 
-    {
-        v = x;   
-        vCoord = BernsteinBasis(x);
-    }
-    else {
-        u = x;
-        uCoord = BernsteinBasis(x);
-    }
+    float u = tc_Direction == 0 ? along : line;
+    float v = tc_Direction == 0 ? line : along;
 
     vec3 mat[4][4];
-    mat[0][0] = gregoryPoints[0];
-    mat[0][1] = gregoryPoints[2];
-    mat[0][2] = gregoryPoints[6];
-    mat[0][3] = gregoryPoints[5];
-    mat[1][3] = gregoryPoints[7];
-    mat[2][3] = gregoryPoints[11];
-    mat[3][3] = gregoryPoints[10];
-    mat[3][2] = gregoryPoints[12];
-    mat[3][1] = gregoryPoints[16];
-    mat[3][0] = gregoryPoints[15];
-    mat[2][0] = gregoryPoints[17];
-    mat[1][0] = gregoryPoints[1];
-
-    vec4 corner[4];
-    corner[0] = u_ViewProjectionMatrix * vec4(gregoryPoints[0], 1);
-    corner[1] = u_ViewProjectionMatrix * vec4(gregoryPoints[5], 1);
-    corner[2] = u_ViewProjectionMatrix * vec4(gregoryPoints[10], 1);
-    corner[3] = u_ViewProjectionMatrix * vec4(gregoryPoints[15], 1);
-    float dist = distance(corner[0].xy / corner[0].w, corner[1].xy / corner[1].w) + 
-        distance(corner[1].xy / corner[1].w, corner[2].xy / corner[2].w) + 
-        distance(corner[2].xy / corner[2].w, corner[3].xy / corner[3].w) +
-        distance(corner[3].xy / corner[3].w, corner[0].xy / corner[0].w);
-    int steps = min(int(dist * 20) + 1, 255);
-    float delta = 1.0 / float(steps);
-    for (int i = 0; i <= steps; ++i) 
-    {
-        if (isForward) 
-        {
-            u = i * delta;
-            uCoord = BernsteinBasis(u);
-        }
-        else 
-        {
-            v = i * delta;
-            vCoord = BernsteinBasis(v);
-        }
-
-        if(u != 0 && u != 1 && v != 0 && v != 1) {
-            mat[1][1] = (u * gregoryPoints[4] + v * gregoryPoints[3]) / (u + v);
-            mat[1][2] = ((1 - u) * gregoryPoints[8] + v * gregoryPoints[9]) / (1 - u + v);
-            mat[2][1] = (u * gregoryPoints[18] + (1 - v) * gregoryPoints[19]) / (1 + u - v);
-            mat[2][2] = ((1 - u) * gregoryPoints[14] + (1 - v) * gregoryPoints[13]) / (2 - u - v);
-        }
-
-        vec4 Pos = vec4(0, 0, 0, 1);
-        for (int j = 0; j < 4; j++)
-            for(int k = 0; k < 4; k++){
-                Pos.xyz += mat[j][k] * uCoord[k] * vCoord[j];
-            }
-        gl_Position = u_ViewProjectionMatrix * Pos;
-        EmitVertex();
-    }
+    mat[0][0] = GregoryPoint(0);
+    mat[0][1] = GregoryPoint(2);
+    mat[0][2] = GregoryPoint(6);
+    mat[0][3] = GregoryPoint(5);
+    mat[1][3] = GregoryPoint(7);
+    mat[2][3] = GregoryPoint(11);
+    mat[3][3] = GregoryPoint(10);
+    mat[3][2] = GregoryPoint(12);
+    mat[3][1] = GregoryPoint(16);
+    mat[3][0] = GregoryPoint(15);
+    mat[2][0] = GregoryPoint(17);
+    mat[1][0] = GregoryPoint(1);
+
+    mat[1][1] = InnerPoint(u, GregoryPoint(4), v, GregoryPoint(3));
+    mat[1][2] = InnerPoint(1 - u, GregoryPoint(8), v, GregoryPoint(9));
+    mat[2][1] = InnerPoint(u, GregoryPoint(18), 1 - v, GregoryPoint(19));
+    mat[2][2] = InnerPoint(1 - u, GregoryPoint(14), 1 - v, GregoryPoint(13));
+
+    vec4 uCoord = BernsteinBasis(u);
+    vec4 vCoord = BernsteinBasis(v);
+
+    vec3 pos = vec3(0.0f);
+    for (int j = 0; j < 4; j++)
+        for (int k = 0; k < 4; k++)
+            pos += mat[j][k] * uCoord[k] * vCoord[j];
+
+    gl_Position = u_ViewProjectionMatrix * vec4(pos, 1.0f);
 }
 
 
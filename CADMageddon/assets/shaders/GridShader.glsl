@@ -0,0 +1,78 @@
+//Grid Shader
+
+#type vertex
+#version 440 core
+
+uniform mat4 u_InverseViewProjectionMatrix;
+
+out vec3 v_NearPoint;
+out vec3 v_FarPoint;
+
+const vec2 positions[4] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+vec3 unproject(vec2 position, float depth)
+{
+    vec4 world = u_InverseViewProjectionMatrix * vec4(position, depth, 1.0);
+    return world.xyz / world.w;
+}
+
+void main()
+{
+    vec2 position = positions[gl_VertexID];
+    v_NearPoint = unproject(position, -1.0);
+    v_FarPoint = unproject(position, 1.0);
+    gl_Position = vec4(position, 0.0, 1.0);
+}
+
+#type fragment
+#version 440 core
+
+layout(location = 0) out vec4 color;
+
+in vec3 v_NearPoint;
+in vec3 v_FarPoint;
+
+uniform mat4 u_ViewProjectionMatrix;
+uniform vec4 u_Color;
+uniform float u_CellSize;
+uniform float u_MinPixelsBetweenCells;
+
+//coverage of the lines of a grid with given cell size, antialiased over one pixel
+float gridLines(vec2 position, float cellSize)
+{
+    vec2 coord = position / cellSize;
+    vec2 derivative = fwidth(coord);
+    vec2 distanceToLine = abs(fract(coord - 0.5) - 0.5) / derivative;
+    return 1.0 - min(min(distanceToLine.x, distanceToLine.y), 1.0);
+}
+
+void main()
+{
+    //grid lies in the y = 0 plane, intersect it with the view ray of this pixel
+    float t = -v_NearPoint.y / (v_FarPoint.y - v_NearPoint.y);
+    if (t <= 0.0)
+        discard;
+
+    vec3 position = v_NearPoint + t * (v_FarPoint - v_NearPoint);
+
+    //spacing grows by 10 whenever cells would get closer than u_MinPixelsBetweenCells on screen
+    vec2 derivative = fwidth(position.xz);
+    float lodLevel = max(0.0, log(length(derivative) * u_MinPixelsBetweenCells / u_CellSize) / log(10.0) + 1.0);
+    float lodFade = fract(lodLevel);
+    float lod0 = u_CellSize * pow(10.0, floor(lodLevel));
+    float lod1 = lod0 * 10.0;
+
+    float alpha = max(gridLines(position.xz, lod1), gridLines(position.xz, lod0) * (1.0 - lodFade));
+
+    //fade out towards the horizon, the visible range grows with the camera height
+    float range = max(abs(v_NearPoint.y), 1.0) * 40.0;
+    alpha *= 1.0 - smoothstep(0.5 * range, range, distance(v_NearPoint, position));
+
+    if (alpha <= 0.001)
+        discard;
+
+    vec4 clipPosition = u_ViewProjectionMatrix * vec4(position, 1.0);
+    gl_FragDepth = 0.5 * (clipPosition.z / clipPosition.w) + 0.5;
+
+    color = vec4(u_Color.rgb, u_Color.a * alpha);
+}
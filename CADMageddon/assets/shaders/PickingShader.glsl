@@ -0,0 +1,32 @@
+//Picking Shader
+
+#type vertex
+#version 440 core
+
+layout (location =0) in vec3 a_Position;
+layout (location =1) in uint a_Id;
+
+uniform mat4 u_ViewProjectionMatrix;
+uniform mat4 u_ModelMatrix;
+uniform bool u_UseVertexId;
+uniform int u_Id;
+
+flat out uint v_Id;
+
+void main()
+{
+    gl_Position = u_ViewProjectionMatrix * u_ModelMatrix * vec4(a_Position, 1.0f);
+    v_Id = u_UseVertexId ? a_Id : uint(u_Id);
+}
+
+#type fragment
+#version 440 core
+
+layout(location = 1) out uint id;
+
+flat in uint v_Id;
+
+void main()
+{
+    id = v_Id;
+}
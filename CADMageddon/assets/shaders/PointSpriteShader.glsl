@@ -0,0 +1,55 @@
+//Point Sprite Shader
+
+#type vertex
+#version 440 core
+
+layout (location = 0) in vec3 a_Position;
+layout (location = 1) in uint a_State;
+
+uniform mat4 u_ViewProjectionMatrix;
+uniform vec2 u_ViewportSize;
+
+//indexed by type * 2 + selected, see PackPointState
+uniform vec4 u_Colors[6];
+uniform float u_Sizes[3];
+
+out vec4 v_Color;
+
+const uint StateSelected = 1u;
+const uint StateVisible = 2u;
+const uint StateTypeShift = 2u;
+
+const vec2 Corners[4] = vec2[](vec2(-1.0f, -1.0f), vec2(1.0f, -1.0f), vec2(-1.0f, 1.0f), vec2(1.0f, 1.0f));
+
+void main()
+{
+    if ((a_State & StateVisible) == 0u)
+    {
+        //outside the clip volume, the sprite is culled before rasterization
+        gl_Position = vec4(2.0f, 2.0f, 2.0f, 1.0f);
+        v_Color = vec4(0.0f);
+        return;
+    }
+
+    int type = int((a_State >> StateTypeShift) & 3u);
+    int selected = int(a_State & StateSelected);
+
+    //the sprite is a screen aligned square of u_Sizes[type] pixels around the projected point
+    vec4 center = u_ViewProjectionMatrix * vec4(a_Position, 1.0f);
+    vec2 offset = Corners[gl_VertexID] * u_Sizes[type] / u_ViewportSize;
+
+    gl_Position = center + vec4(offset * center.w, 0.0f, 0.0f);
+    v_Color = u_Colors[type * 2 + selected];
+}
+
+#type fragment
+#version 440 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+    color = v_Color;
+}
@@ -0,0 +1,186 @@
+#include "Benchmark.h"
+#include <glad\glad.h>
+#include <glm\gtc\constants.hpp>
+#include <glm\gtx\rotate_vector.hpp>
+#include <chrono>
+#include <fstream>
+
+#include "Rendering\Renderer.h"
+#include "Rendering\FrameBuffer.h"
+#include "Serialization\SceneSerializer.h"
+
+namespace CADMageddon
+{
+    bool BenchmarkSettings::ParseCommandLine(int argc, char** argv, BenchmarkSettings& settings)
+    {
+        bool isRequested = false;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "--benchmark" && hasValue)
+            {
+                settings.ScenePath = argv[++i];
+                isRequested = true;
+            }
+            else if (argument == "--frames" && hasValue)
+                settings.FrameCount = std::max(std::atoi(argv[++i]), 1);
+            else if (argument == "--size" && i + 2 < argc)
+            {
+                settings.Width = std::max(std::atoi(argv[++i]), 1);
+                settings.Height = std::max(std::atoi(argv[++i]), 1);
+            }
+            else if (argument == "--headless")
+                settings.Headless = true;
+            else if (argument == "--export" && hasValue)
+                settings.ExportPath = argv[++i];
+        }
+
+        return isRequested;
+    }
+
+    Benchmark::Benchmark(const BenchmarkSettings& settings)
+        :m_Settings(settings)
+    {
+    }
+
+    bool Benchmark::Run()
+    {
+        if (!std::ifstream(m_Settings.ScenePath).good())
+        {
+            LOG_ERROR("Could not open benchmark scene {0}", m_Settings.ScenePath);
+            return false;
+        }
+
+        auto scene = SceneSerializer::LoadScene(m_Settings.ScenePath);
+
+        FramebufferSpecification spec;
+        spec.Width = m_Settings.Width;
+        spec.Height = m_Settings.Height;
+        auto framebuffer = CreateRef<OpenGLFramebuffer>(spec);
+
+        //same starting point as the editor camera, orbiting so culling and tessellation levels change every frame
+        FPSCamera camera(45.0f, (float)m_Settings.Width / m_Settings.Height, 0.1f, 1000.0f);
+        const glm::vec3 startPosition = { 0.0f, 2.5f, 15.0f };
+
+        glViewport(0, 0, m_Settings.Width, m_Settings.Height);
+        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+        glEnable(GL_DEPTH_TEST);
+
+        m_Frames.clear();
+        m_Frames.reserve(m_Settings.FrameCount);
+
+        int totalFrameCount = m_Settings.WarmupFrameCount + m_Settings.FrameCount;
+        for (int frame = 0; frame < totalFrameCount; frame++)
+        {
+            float angle = glm::two_pi<float>() * frame / m_Settings.FrameCount;
+            camera.SetPosition(glm::rotateY(startPosition, angle));
+            camera.SetRotation({ 0.0f, angle });
+
+            Renderer::ResetStats();
+            auto frameStart = std::chrono::high_resolution_clock::now();
+
+            framebuffer->Bind();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            Renderer::BeginScene(camera.GetViewProjectionMatrix());
+            scene->Update();
+            Renderer::RenderGrid(glm::vec4(1.0f));
+            Renderer::EndScene();
+
+            framebuffer->UnBind();
+
+            auto cpuEnd = std::chrono::high_resolution_clock::now();
+            glFinish();
+            auto frameEnd = std::chrono::high_resolution_clock::now();
+
+            if (frame < m_Settings.WarmupFrameCount)
+                continue;
+
+            BenchmarkFrame result;
+            result.CpuTime = std::chrono::duration<float, std::milli>(cpuEnd - frameStart).count();
+            result.FrameTime = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
+            result.DrawCalls = Renderer::GetStats().DrawCalls;
+            result.BytesUploaded = Renderer::GetStats().BytesUploaded;
+            m_Frames.push_back(result);
+        }
+
+        Report();
+
+        if (!m_Settings.ExportPath.empty())
+            return ExportCsv(m_Settings.ExportPath);
+
+        return true;
+    }
+
+    void Benchmark::Report() const
+    {
+        std::vector<float> cpuTimes;
+        std::vector<float> frameTimes;
+        uint64_t drawCalls = 0;
+        uint64_t bytesUploaded = 0;
+        for (const auto& frame : m_Frames)
+        {
+            cpuTimes.push_back(frame.CpuTime);
+            frameTimes.push_back(frame.FrameTime);
+            drawCalls += frame.DrawCalls;
+            bytesUploaded += frame.BytesUploaded;
+        }
+
+        auto cpuStats = GetStats(cpuTimes);
+        auto frameStats = GetStats(frameTimes);
+        auto frameCount = std::max<size_t>(m_Frames.size(), 1);
+
+        LOG_INFO("Benchmark: {0}, {1} frames at {2}x{3}", m_Settings.ScenePath, m_Frames.size(), m_Settings.Width, m_Settings.Height);
+        LOG_INFO("  CPU time ms:   avg {0:.3f} p50 {1:.3f} p95 {2:.3f} p99 {3:.3f} max {4:.3f}",
+            cpuStats.Average, cpuStats.P50, cpuStats.P95, cpuStats.P99, cpuStats.Max);
+        LOG_INFO("  Frame time ms: avg {0:.3f} p50 {1:.3f} p95 {2:.3f} p99 {3:.3f} max {4:.3f}",
+            frameStats.Average, frameStats.P50, frameStats.P95, frameStats.P99, frameStats.Max);
+        LOG_INFO("  Draw calls per frame: {0}", drawCalls / frameCount);
+        LOG_INFO("  Bytes uploaded per frame: {0}", bytesUploaded / frameCount);
+    }
+
+    bool Benchmark::ExportCsv(const std::string& filePath) const
+    {
+        std::ofstream file(filePath);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Could not open {0} for benchmark export", filePath);
+            return false;
+        }
+
+        file << "frame,cpu ms,frame ms,draw calls,bytes uploaded\n";
+        for (int i = 0; i < m_Frames.size(); i++)
+        {
+            const auto& frame = m_Frames[i];
+            file << i << "," << frame.CpuTime << "," << frame.FrameTime << "," << frame.DrawCalls << "," << frame.BytesUploaded << "\n";
+        }
+
+        LOG_INFO("Exported {0} benchmark frames to {1}", m_Frames.size(), filePath);
+        return true;
+    }
+
+    ProfileStats Benchmark::GetStats(std::vector<float> samples)
+    {
+        ProfileStats stats;
+        if (samples.empty())
+            return stats;
+
+        std::sort(samples.begin(), samples.end());
+
+        float sum = 0.0f;
+        for (auto sample : samples)
+            sum += sample;
+
+        auto percentile = [&samples](float p) { return samples[std::min((int)(p * samples.size()), (int)samples.size() - 1)]; };
+
+        stats.Average = sum / samples.size();
+        stats.P50 = percentile(0.50f);
+        stats.P95 = percentile(0.95f);
+        stats.P99 = percentile(0.99f);
+        stats.Max = samples.back();
+
+        return stats;
+    }
+}
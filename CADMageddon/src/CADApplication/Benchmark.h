@@ -0,0 +1,54 @@
+#pragma once
+#include "cadpch.h"
+#include "Core\Profiler.h"
+
+namespace CADMageddon
+{
+    struct BenchmarkSettings
+    {
+        std::string ScenePath;
+        std::string ExportPath;
+        int FrameCount = 300;
+        //not measured, lets shader compilation and buffer allocation settle first
+        int WarmupFrameCount = 10;
+        uint32_t Width = 1280;
+        uint32_t Height = 720;
+        bool Headless = false;
+
+        //CADMageddon --benchmark <scene.xml> [--frames N] [--size W H] [--headless] [--export file.csv]
+        //returns false when the benchmark was not requested
+        static bool ParseCommandLine(int argc, char** argv, BenchmarkSettings& settings);
+    };
+
+    struct BenchmarkFrame
+    {
+        //time to record and submit the frame, and the same including glFinish
+        float CpuTime = 0.0f;
+        float FrameTime = 0.0f;
+        uint32_t DrawCalls = 0;
+        uint64_t BytesUploaded = 0;
+    };
+
+    // Renders a loaded scene into an offscreen framebuffer for a fixed number of frames
+    // while the camera orbits the origin, then reports the timings and renderer counters.
+    // Needs a current OpenGL context and an initialized Renderer.
+    class Benchmark
+    {
+    public:
+        Benchmark(const BenchmarkSettings& settings);
+
+        bool Run();
+
+        const std::vector<BenchmarkFrame>& GetFrames() const { return m_Frames; }
+
+    private:
+        void Report() const;
+        bool ExportCsv(const std::string& filePath) const;
+
+        static ProfileStats GetStats(std::vector<float> samples);
+
+    private:
+        BenchmarkSettings m_Settings;
+        std::vector<BenchmarkFrame> m_Frames;
+    };
+}
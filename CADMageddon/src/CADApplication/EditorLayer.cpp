@@ -14,8 +14,8 @@
 
 #include "Core/Application.h"
 #include "Core/Input.h"
+#include "Core/Profiler.h"
 
-#include "Scene/ObjectFactory.h"
 
 #include "Gizmos\Gizmo.h"
 
@@ -46,13 +46,22 @@ namespace CADMageddon
         m_HierarchyPanel->SetOnSelectionClearedCallback(std::bind(&EditorLayer::OnSelectionCleared, this));
 
         m_InspectorPanel = CreateRef<InspectorPanel>(m_Scene, m_TransformationSystem,m_CursorController.getCursor());
+        m_ProfilerPanel = CreateRef<ProfilerPanel>();
 
         m_PickingSystem->SetOnPointSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedPoint, this, std::placeholders::_1, std::placeholders::_2));
         m_PickingSystem->SetOnTorusSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedTorus, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnBezierC0SelectionChanged(std::bind(&EditorLayer::OnSelectionChangedBezierC0, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnBSplineSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedBSpline, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnInterpolatedSelectionChanged(std::bind(&EditorLayer::OnSelectionInterpolatedChanged, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnBezierPatchSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedBezierPatch, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnBSplinePatchSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedBSplinePatch, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnGregoryPatchSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedGregoryPatch, this, std::placeholders::_1, std::placeholders::_2));
+        m_PickingSystem->SetOnIntersectionCurveSelectionChanged(std::bind(&EditorLayer::OnSelectionChangedIntersectionCurve, this, std::placeholders::_1, std::placeholders::_2));
         m_PickingSystem->SetOnSelectionCleared(std::bind(&EditorLayer::OnPickingSelectionCleared, this));
 
         m_Scene->SetOnPointMerged(std::bind(&EditorLayer::OnPointsMergedCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         m_Scene->SetOnGregoryPatchDeleted(std::bind(&EditorLayer::OnGregoryDeletedCallback, this, std::placeholders::_1));
+        m_Scene->SetOnChanged([]() { Application::Get().RequestRedraw(); });
     }
 
     void EditorLayer::OnAttach()
@@ -64,12 +73,13 @@ namespace CADMageddon
         FramebufferSpecification fbSpec;
         fbSpec.Width = 1280;
         fbSpec.Height = 720;
+        fbSpec.HasPickingAttachment = true;
         m_Framebuffer = CreateRef<OpenGLFramebuffer>(fbSpec);
+        fbSpec.HasPickingAttachment = false;
         m_FramebufferLeft = CreateRef<OpenGLFramebuffer>(fbSpec);
         m_FramebufferRight = CreateRef<OpenGLFramebuffer>(fbSpec);
 
         InitImGui();
-        InitGridVertexArray();
         InitQuadVertexArray();
         InitQuadShader();
 
@@ -122,12 +132,12 @@ namespace CADMageddon
     {
         if (selected)
         {
-            m_TransformationSystem->AddToSelected(point->GetTransform());
+            m_TransformationSystem->AddToSelected(point->GetHandle());
             m_InspectorPanel->AddPoint(point);
         }
         else
         {
-            m_TransformationSystem->RemoveFromSelected(point->GetTransform());
+            m_TransformationSystem->RemoveFromSelected(point->GetHandle());
             m_InspectorPanel->RemovePoint(point);
         }
     }
@@ -235,8 +245,8 @@ namespace CADMageddon
         m_InspectorPanel->RemovePoint(p1);
         m_InspectorPanel->RemovePoint(p2);
 
-        m_TransformationSystem->RemoveFromSelected(p1->GetTransform());
-        m_TransformationSystem->RemoveFromSelected(p2->GetTransform());
+        m_TransformationSystem->RemoveFromSelected(p1->GetHandle());
+        m_TransformationSystem->RemoveFromSelected(p2->GetHandle());
     }
 
     void EditorLayer::OnGregoryDeletedCallback(Ref<GregoryPatch> gregory)
@@ -247,7 +257,10 @@ namespace CADMageddon
     void EditorLayer::OnPickingSelectionCleared()
     {
         m_TransformationSystem->ClearSelection();
-        m_InspectorPanel->ClearPointsAndToruses();
+        if (m_PickingSystem->GetUseGpuPicking())
+            m_InspectorPanel->Clear();
+        else
+            m_InspectorPanel->ClearPointsAndToruses();
     }
 
     void EditorLayer::OnSelectionCleared()
@@ -336,22 +349,6 @@ namespace CADMageddon
         ImGui_ImplOpenGL3_Init("#version 410");
     }
 
-    void EditorLayer::InitGridVertexArray()
-    {
-        m_GridVertexArray = CreateRef<OpenGLVertexArray>();
-        auto gridMesh = ObjectFactory::CreateGridMesh(200.0f, 200.0f);
-
-        auto vertexBuffer = CreateRef<OpenGLVertexBuffer>(&gridMesh.Vertices[0].x, gridMesh.Vertices.size() * 3 * sizeof(float));
-        auto indexBuffer = CreateRef<OpenGLIndexBuffer>(gridMesh.Indices.data(), gridMesh.Indices.size());
-
-        vertexBuffer->SetLayout({
-            { ShaderDataType::Float3, "a_Position" }
-            });
-
-        m_GridVertexArray->AddVertexBuffer(vertexBuffer);
-        m_GridVertexArray->SetIndexBuffer(indexBuffer);
-    }
-
     void EditorLayer::InitQuadVertexArray()
     {
         float quadVertices[24] = {
@@ -412,6 +409,13 @@ namespace CADMageddon
             m_CursorController.UpdateWorldPosition(m_CursorController.getCursor()->getPosition());
         }
 
+        //keys held to move the camera send no events, keep rendering while the camera is moving
+        if (m_CameraController.GetCamera().GetViewProjectionMatrix() != m_LastViewProjectionMatrix)
+        {
+            m_LastViewProjectionMatrix = m_CameraController.GetCamera().GetViewProjectionMatrix();
+            Application::Get().RequestRedraw();
+        }
+
         if (!m_BlockEvents && Input::IsMouseButtonPressed(CDM_MOUSE_BUTTON_LEFT) && m_EditorMode == EditorMode::MoveCursor)
         {
             auto pos = ImGui::GetIO().MousePos;
@@ -420,6 +424,13 @@ namespace CADMageddon
             m_CursorController.Update(ts, m_CameraController.GetCamera(), viewPortMousePosition);
         }
 
+        if (m_PickingSystem->HasPickingRequest())
+        {
+            CDM_PROFILE_SCOPE("Picking pass");
+            m_PickingSystem->RenderPickingPass(*m_Scene, m_Framebuffer, m_CameraController.GetCamera());
+        }
+        m_PickingSystem->ResolvePicking(*m_Scene);
+
         if (!m_EnableStereoscopic)
         {
             m_Framebuffer->Bind();
@@ -428,15 +439,18 @@ namespace CADMageddon
 
             Renderer::BeginScene(m_CameraController.GetCamera().GetViewProjectionMatrix());
 
-            m_Scene->Update();
+            {
+                CDM_PROFILE_SCOPE("Scene::Update");
+                m_Scene->Update();
+            }
             if (m_ShowGrid)
-                Renderer::RenderGrid(m_GridVertexArray, glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec4(1.0f));
+                Renderer::RenderGrid(glm::vec4(1.0f));
             const float cursorSize = 1.0f;
             RenderCursor(m_CursorController.getCursor()->getPosition(), cursorSize);
 
             if (m_TransformationSystem->GetCount() > 1)
             {
-                Renderer::RenderPoint(m_TransformationSystem->GetTransformationCenter(), glm::vec4(1.0f, 0.0f, 1.0f, 1.0f));
+                Renderer::RenderPoint(m_TransformationSystem->GetTransformationCenter(), PackPointState(PointType::Marker));
             }
 
             if (IsEditMode())
@@ -452,27 +466,29 @@ namespace CADMageddon
                 m_PickingSystem->UpdateMultiSelect(viewPortMousePosition, m_ViewportSize, *(m_Scene.get()), m_CameraController.GetCamera());
             }
 
-            Renderer::EndScene();
+            {
+                CDM_PROFILE_SCOPE("Renderer::EndScene");
+                Renderer::EndScene();
+            }
 
             m_Framebuffer->UnBind();
         }
         else
         {
-            m_FramebufferLeft->Bind();
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
+            //the frame is recorded once and replayed for each eye in the eye's color
             auto leftEyeMatrix = m_CameraController.GetCamera().GetLeftEyeProjectionMatrix() * m_CameraController.GetCamera().GetLeftViewMatrix();
-            Renderer::BeginScene(leftEyeMatrix);
-
+            auto rightEyeMatrix = m_CameraController.GetCamera().GetRightEyeProjectionMatrix() * m_CameraController.GetCamera().GetRightViewMatrix();
+            Renderer::BeginStereoScene(leftEyeMatrix, rightEyeMatrix);
 
-            m_Scene->SetDefaultColor(m_LeftEyeColor);
-            m_Scene->SetSelectionColor(m_LeftEyeColor);
-            m_Scene->Update();
+            {
+                CDM_PROFILE_SCOPE("Scene::Update");
+                m_Scene->Update();
+            }
             if (m_ShowGrid)
-                Renderer::RenderGrid(m_GridVertexArray, glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)), m_LeftEyeColor);
+                Renderer::RenderGrid();
 
             const float cursorSize = 1.0f;
-            RenderCursor(m_CursorController.getCursor()->getPosition(), cursorSize, m_LeftEyeColor);
+            RenderCursor(m_CursorController.getCursor()->getPosition(), cursorSize);
 
             if (IsEditMode())
             {
@@ -487,31 +503,18 @@ namespace CADMageddon
                 m_PickingSystem->UpdateMultiSelect(viewPortMousePosition, m_ViewportSize, *(m_Scene.get()), m_CameraController.GetCamera());
             }
 
-            Renderer::EndScene();
-
-            m_FramebufferRight->Bind();
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            auto rightEyeMatrix = m_CameraController.GetCamera().GetRightEyeProjectionMatrix() * m_CameraController.GetCamera().GetRightViewMatrix();
-            Renderer::BeginScene(rightEyeMatrix);
-
-            m_Scene->SetDefaultColor(m_RightEyeColor);
-            m_Scene->SetSelectionColor(m_RightEyeColor);
-            m_Scene->Update();
-
-            if (m_ShowGrid)
-                Renderer::RenderGrid(m_GridVertexArray, glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)), m_RightEyeColor);
-
-            RenderCursor(m_CursorController.getCursor()->getPosition(), cursorSize, m_RightEyeColor);
-
-            if (IsEditMode())
             {
-                auto pos = ImGui::GetIO().MousePos;
-                m_TransformationSystem->Update(m_Scene, m_CameraController.GetCamera(), GetNDCMousePosition({ pos.x,pos.y }));
+                CDM_PROFILE_SCOPE("Renderer::EndScene");
+                m_FramebufferLeft->Bind();
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                Renderer::SubmitScene(leftEyeMatrix, m_LeftEyeColor);
+
+                m_FramebufferRight->Bind();
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                Renderer::SubmitScene(rightEyeMatrix, m_RightEyeColor);
             }
 
-            Renderer::EndScene();
-
+            CDM_PROFILE_SCOPE("Stereo composite");
             m_Framebuffer->Bind();
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -532,6 +535,7 @@ namespace CADMageddon
 
         }
 
+        CDM_PROFILE_SCOPE("ImGui");
         RenderImGui();
     }
 
@@ -614,6 +618,7 @@ namespace CADMageddon
         m_InspectorPanel->Render();
         RenderViewport();
         RenderOptions();
+        m_ProfilerPanel->Render();
 
         //ImGui::ShowDemoWindow();
 
@@ -677,6 +682,7 @@ namespace CADMageddon
                         0);
                     if (lTheOpenFileName) {
                         m_Scene = SceneSerializer::LoadScene(lTheOpenFileName);
+                        m_Scene->SetOnChanged([]() { Application::Get().RequestRedraw(); });
                         m_HierarchyPanel->SetScene(m_Scene);
                         m_InspectorPanel->SetScene(m_Scene);
                         m_TransformationSystem->ClearSelection();
@@ -931,6 +937,14 @@ namespace CADMageddon
             glPointSize(Renderer::PointSize);
         }
 
+        bool useGpuPicking = m_PickingSystem->GetUseGpuPicking();
+        if (ImGui::Checkbox("GPU picking", &useGpuPicking))
+            m_PickingSystem->SetUseGpuPicking(useGpuPicking);
+
+        bool continuousRendering = Application::Get().GetContinuousRendering();
+        if (ImGui::Checkbox("Continuous rendering", &continuousRendering))
+            Application::Get().SetContinuousRendering(continuousRendering);
+
         ImGui::EndGroup();
 
         ImGui::BeginGroup();
@@ -1013,11 +1027,7 @@ namespace CADMageddon
             if (m_EnableStereoscopic)
                 glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
             else
-            {
                 glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-                m_Scene->SetDefaultColor(Renderer::DEFAULT_COLOR);
-                m_Scene->SetSelectionColor(Renderer::SELECTED_COLOR);
-            }
         }
 
         auto eyeDistance = m_CameraController.GetCamera().GetEyeDistance();
@@ -14,6 +14,7 @@
 
 #include "CADApplication/Panels/HierarchyPanel.h"
 #include "CADApplication/Panels/InspectorPanel.h"
+#include "CADApplication/Panels/ProfilerPanel.h"
 
 namespace CADMageddon
 {
@@ -62,7 +63,6 @@ namespace CADMageddon
         void InitImGui();
         void ShutDownImGui();
         void RenderImGui();
-        void InitGridVertexArray();
         void InitQuadVertexArray();
         void InitQuadShader();
 
@@ -76,7 +76,6 @@ namespace CADMageddon
         bool IsMouseInsideViewPort();
 
     private:
-        Ref<OpenGLVertexArray> m_GridVertexArray;
         Ref<OpenGLVertexArray> m_QuadVertexArray;
         Ref<OpenGLShader> m_QuadShader;
 
@@ -108,6 +107,7 @@ namespace CADMageddon
         glm::vec4 m_RightEyeColor = glm::vec4(0, 0, 1, 1.0f);
 
         bool m_ShowGrid = true;
+        glm::mat4 m_LastViewProjectionMatrix = glm::mat4(1.0f);
 
         Ref<Scene> m_Scene;
         EditorMode m_EditorMode = EditorMode::MoveCursor;
@@ -119,6 +119,7 @@ namespace CADMageddon
 
         Ref<HierarchyPanel> m_HierarchyPanel;
         Ref<InspectorPanel> m_InspectorPanel;
+        Ref<ProfilerPanel> m_ProfilerPanel;
 
         Ref<OpenGLTexture2D> m_FishTexture;
     };
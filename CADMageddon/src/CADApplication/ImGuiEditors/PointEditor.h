@@ -22,10 +22,10 @@ namespace CADMageddon
             point->SetIsVisible(visible);
         }
 
-        auto position = point->GetTransform()->Translation;
+        auto position = point->GetTransform().GetTranslation();
         if (ImGui::DragFloat3("Position", &position.x, 0.1f))
         {
-            point->GetTransform()->Translation = position;
+            point->GetTransform().SetTranslation(position);
         }
 
         
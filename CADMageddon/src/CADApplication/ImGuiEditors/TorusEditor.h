@@ -17,22 +17,22 @@ namespace CADMageddon
             torus->SetName(name);
         }
 
-        auto position = torus->GetTransform()->Translation;
+        auto position = torus->GetTransform()->GetTranslation();
         if (ImGui::DragFloat3("Position", &position.x, 0.1f))
         {
-            torus->GetTransform()->Translation = position;
+            torus->GetTransform()->SetTranslation(position);
         }
 
-        auto rotation = torus->GetTransform()->Rotation;
+        auto rotation = torus->GetTransform()->GetRotation();
         if (ImGui::DragFloat3("Rotation", &rotation.x))
         {
-            torus->GetTransform()->Rotation = rotation;
+            torus->GetTransform()->SetRotation(rotation);
         }
 
-        auto scale = torus->GetTransform()->Scale;
+        auto scale = torus->GetTransform()->GetScale();
         if (ImGui::DragFloat3("Scale", &scale.x, 0.1f))
         {
-            torus->GetTransform()->Scale = scale;
+            torus->GetTransform()->SetScale(scale);
         }
 
         auto& torusParameters = torus->GetTorusParameters();
@@ -23,7 +23,7 @@ namespace CADMageddon
             ImGui::EndPopup();
         }*/
 
-        auto points = m_Scene->GetFreePoints();
+        const auto& points = m_Scene->GetFreePoints();
         if (!points.empty() && ImGui::TreeNode("Points"))
         {
             int id = 0;
@@ -35,7 +35,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto toruses = m_Scene->GetTorus();
+        const auto& toruses = m_Scene->GetTorus();
         if (!toruses.empty() && ImGui::TreeNode("Toruses"))
         {
             int id = 0;
@@ -47,7 +47,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto beziersC0 = m_Scene->GetBezierC0();
+        const auto& beziersC0 = m_Scene->GetBezierC0();
         if (!beziersC0.empty() && ImGui::TreeNode("BezierC0"))
         {
             int id = 0;
@@ -59,7 +59,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto bSplines = m_Scene->GetBSpline();
+        const auto& bSplines = m_Scene->GetBSpline();
         if (!bSplines.empty() && ImGui::TreeNode("BSpline"))
         {
             int id = 0;
@@ -71,7 +71,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto interpolated = m_Scene->GetInterpolated();
+        const auto& interpolated = m_Scene->GetInterpolated();
         if (!interpolated.empty() && ImGui::TreeNode("Interpolated"))
         {
             int id = 0;
@@ -83,7 +83,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto bezierPatches = m_Scene->GetBezierPatch();
+        const auto& bezierPatches = m_Scene->GetBezierPatch();
         if (!bezierPatches.empty() && ImGui::TreeNode("BezierPatches"))
         {
             int id = 0;
@@ -95,7 +95,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto bSplinePatches = m_Scene->GetBSplinePatch();
+        const auto& bSplinePatches = m_Scene->GetBSplinePatch();
         if (!bSplinePatches.empty() && ImGui::TreeNode("BSplinePatches"))
         {
             int id = 0;
@@ -107,7 +107,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto gregoryPatch = m_Scene->GetGregoryPatch();
+        const auto& gregoryPatch = m_Scene->GetGregoryPatch();
         if (!gregoryPatch.empty() && ImGui::TreeNode("GregoryPatches"))
         {
             int id = 0;
@@ -119,7 +119,7 @@ namespace CADMageddon
             ImGui::TreePop();
         }
 
-        auto intersectionCurves = m_Scene->GetIntersectionCurve();
+        const auto& intersectionCurves = m_Scene->GetIntersectionCurve();
         if (!intersectionCurves.empty() && ImGui::TreeNode("Intersection Curves"))
         {
             int id = 0;
@@ -137,50 +137,7 @@ namespace CADMageddon
 
     void HierarchyPanel::ClearSelection()
     {
-        for (auto point : m_Scene->GetPoints())
-        {
-            point->SetIsSelected(false);
-        }
-
-        for (auto torus : m_Scene->GetTorus())
-        {
-            torus->SetIsSelected(false);
-        }
-
-        for (auto bezier : m_Scene->GetBezierC0())
-        {
-            bezier->SetIsSelected(false);
-        }
-
-        for (auto bSpline : m_Scene->GetBSpline())
-        {
-            bSpline->SetIsSelected(false);
-        }
-
-        for (auto interpolated : m_Scene->GetInterpolated())
-        {
-            interpolated->SetIsSelected(false);
-        }
-
-        for (auto bezierPatch : m_Scene->GetBezierPatch())
-        {
-            bezierPatch->SetIsSelected(false);
-        }
-
-        for (auto bSplinePatch : m_Scene->GetBSplinePatch())
-        {
-            bSplinePatch->SetIsSelected(false);
-        }
-
-        for (auto gregory : m_Scene->GetGregoryPatch())
-        {
-            gregory->SetIsSelected(false);
-        }
-
-        for (auto intersection : m_Scene->GetIntersectionCurve())
-        {
-            intersection->SetIsSelected(false);
-        }
+        m_Scene->ClearSelection();
 
         if (m_OnSelectionCleared)
             m_OnSelectionCleared();
@@ -301,10 +258,11 @@ namespace CADMageddon
 
         if (node_open && !isBezierEmpty)
         {
+            //copied, removing a point from the context menu changes the list
             auto points = bezierC0->GetControlPoints();
             for (auto point : points)
             {
-                RenderBezierControlPointNode(bezierC0, point, id);
+                RenderBezierControlPointNode(bezierC0, Point::FromHandle(point), id);
             }
 
             ImGui::TreePop();
@@ -404,10 +362,11 @@ namespace CADMageddon
 
         if (node_open && !isBSplineEmpty)
         {
+            //copied, removing a point from the context menu changes the list
             auto points = bSpline->GetControlPoints();
             for (auto point : points)
             {
-                RenderBSplineControlPointNode(bSpline, point, id);
+                RenderBSplineControlPointNode(bSpline, Point::FromHandle(point), id);
             }
 
             ImGui::TreePop();
@@ -507,10 +466,11 @@ namespace CADMageddon
 
         if (node_open && !isBSplineEmpty)
         {
+            //copied, removing a point from the context menu changes the list
             auto points = interpolatedCurve->GetControlPoints();
             for (auto point : points)
             {
-                RenderIntrepolaterdCurveControlPointNode(interpolatedCurve, point, id);
+                RenderIntrepolaterdCurveControlPointNode(interpolatedCurve, Point::FromHandle(point), id);
             }
 
             ImGui::TreePop();
@@ -600,10 +560,10 @@ namespace CADMageddon
 
         if (node_open && !isBezierPatchEmpty)
         {
-            auto points = bezierPatch->GetControlPoints();
+            const auto& points = bezierPatch->GetControlPoints();
             for (auto point : points)
             {
-                RenderBezierPatchControlPointNode(bezierPatch, point, id);
+                RenderBezierPatchControlPointNode(bezierPatch, Point::FromHandle(point), id);
             }
 
             ImGui::TreePop();
@@ -683,10 +643,10 @@ namespace CADMageddon
 
         if (node_open && !isBSplinePatchEmpty)
         {
-            auto points = bSplinePatch->GetControlPoints();
+            const auto& points = bSplinePatch->GetControlPoints();
             for (auto point : points)
             {
-                RenderBSplinePatchControlPointNode(bSplinePatch, point, id);
+                RenderBSplinePatchControlPointNode(bSplinePatch, Point::FromHandle(point), id);
             }
 
             ImGui::TreePop();
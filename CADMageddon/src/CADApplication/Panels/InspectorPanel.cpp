@@ -176,7 +176,7 @@ namespace CADMageddon
 
         if (ImPlot::BeginPlot("plot 1", "U", "V", ImVec2(-1, 0), ImPlotFlags_Default ^ ImPlotFlags_Legend))
         {
-            auto boundary = intersectionCurve->GetFirstBoundary();
+            const auto& boundary = intersectionCurve->GetFirstBoundary();
             for (int i = 0; i < boundary.size(); i++)
             {
                 if (boundary[i].empty())
@@ -202,7 +202,7 @@ namespace CADMageddon
 
         if (ImPlot::BeginPlot("plot 2", "U", "V", ImVec2(-1, 0), ImPlotFlags_Default ^ ImPlotFlags_Legend))
         {
-            auto domainLoops = intersectionCurve->GetFirstSurfaceDomainLoops();
+            const auto& domainLoops = intersectionCurve->GetFirstSurfaceDomainLoops();
             for (int i = 0; i < domainLoops.size(); i++)
             {
                 if (domainLoops[i].empty())
@@ -228,7 +228,7 @@ namespace CADMageddon
         ImPlot::SetNextPlotLimits(0, size, 0, size);
         if (ImPlot::BeginPlot("plot 3", "U", "V", ImVec2(-1, 0), ImPlotFlags_Default ^ ImPlotFlags_Legend))
         {
-            auto boundary = intersectionCurve->GetSecondBoundary();
+            const auto& boundary = intersectionCurve->GetSecondBoundary();
             for (int i = 0; i < boundary.size(); i++)
             {
                 if (boundary[i].empty())
@@ -254,7 +254,7 @@ namespace CADMageddon
 
         if (ImPlot::BeginPlot("plot 4", "U", "V", ImVec2(-1, 0), ImPlotFlags_Default ^ ImPlotFlags_Legend))
         {
-            auto domainLoops = intersectionCurve->GetSecondSurfaceDomainLoops();
+            const auto& domainLoops = intersectionCurve->GetSecondSurfaceDomainLoops();
             for (int i = 0; i < domainLoops.size(); i++)
             {
                 if (domainLoops[i].empty())
@@ -326,7 +326,7 @@ namespace CADMageddon
         if (!areAllSinglePatch)
             return;
 
-        Ref<Point> commonPoints[3];
+        PointHandle commonPoints[3];
         if (!GetCommonPoint(b1, b2, commonPoints[0]))
             return;
         if (!GetCommonPoint(b2, b3, commonPoints[1]))
@@ -408,12 +408,12 @@ namespace CADMageddon
         }
     }
 
-    bool InspectorPanel::GetCommonPoint(Ref<BezierPatch> b1, Ref<BezierPatch> b2, Ref<Point>& commonPoint)
+    bool InspectorPanel::GetCommonPoint(Ref<BezierPatch> b1, Ref<BezierPatch> b2, PointHandle& commonPoint)
     {
-        auto b1ControlPoints = b1->GetControlPoints();
-        auto b2ControloPoints = b2->GetControlPoints();
+        const auto& b1ControlPoints = b1->GetControlPoints();
+        const auto& b2ControloPoints = b2->GetControlPoints();
 
-        std::vector<Ref<Point>> commonPoints;
+        std::vector<PointHandle> commonPoints;
         for (int i = 0; i < b1ControlPoints.size(); i++)
         {
             for (int j = 0; j < b2ControloPoints.size(); j++)
@@ -437,11 +437,11 @@ namespace CADMageddon
         return true;
     }
 
-    bool InspectorPanel::CheckIfCorner(Ref<BezierPatch> b, Ref<Point> commonPoint)
+    bool InspectorPanel::CheckIfCorner(Ref<BezierPatch> b, PointHandle commonPoint)
     {
         const int cornersSize = 4;
         int corners[] = { 0,3,12,15 };
-        auto controlPoints = b->GetControlPoints();
+        const auto& controlPoints = b->GetControlPoints();
 
         for (int i = 0; i < cornersSize; i++)
         {
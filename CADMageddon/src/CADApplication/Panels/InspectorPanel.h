@@ -54,8 +54,8 @@ namespace CADMageddon
         void RenderFindIntersectionInspector();
         void GetIntersectionSurfaces(Ref<SurfaceUV>& s1, Ref<SurfaceUV>& s2);
 
-        bool GetCommonPoint(Ref<BezierPatch> b1, Ref<BezierPatch> b2, Ref<Point>& commonPoint);
-        bool CheckIfCorner(Ref<BezierPatch> b, Ref<Point> commonPoint);
+        bool GetCommonPoint(Ref<BezierPatch> b1, Ref<BezierPatch> b2, PointHandle& commonPoint);
+        bool CheckIfCorner(Ref<BezierPatch> b, PointHandle commonPoint);
 
 
     private:
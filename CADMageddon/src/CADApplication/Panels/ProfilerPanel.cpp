@@ -0,0 +1,117 @@
+#include "ProfilerPanel.h"
+#include "Core\Profiler.h"
+#include "imgui.h"
+#include "misc\cpp\imgui_stdlib.h"
+#include "ImGui\implot.h"
+
+namespace CADMageddon
+{
+    void ProfilerPanel::Render()
+    {
+        ImGui::Begin("Profiler");
+
+        bool isEnabled = Profiler::GetIsEnabled();
+        if (ImGui::Checkbox("Enabled", &isEnabled))
+        {
+            Profiler::SetIsEnabled(isEnabled);
+        }
+
+        if (!Profiler::GetIsEnabled())
+        {
+            ImGui::End();
+            return;
+        }
+
+        ImGui::SameLine();
+        ImGui::Checkbox("GPU", &m_ShowGpu);
+
+        ImGui::InputText("File", &m_ExportPath);
+        ImGui::SameLine();
+        if (ImGui::Button("Export CSV"))
+        {
+            Profiler::ExportCsv(m_ExportPath);
+        }
+
+        ImGui::InputText("Trace file", &m_TracePath);
+        ImGui::SameLine();
+        if (ImGui::Button("Export trace"))
+        {
+            Profiler::ExportTrace(m_TracePath);
+        }
+
+        ImGui::Separator();
+        RenderStatsTable();
+
+        RenderHistoryPlot("CPU ms", false);
+        if (m_ShowGpu)
+            RenderHistoryPlot("GPU ms", true);
+
+        ImGui::End();
+    }
+
+    void ProfilerPanel::RenderStatsTable()
+    {
+        ImGui::Columns(m_ShowGpu ? 7 : 5, "ProfilerStats");
+        ImGui::Text("Section"); ImGui::NextColumn();
+        ImGui::Text("CPU avg"); ImGui::NextColumn();
+        ImGui::Text("CPU p50"); ImGui::NextColumn();
+        ImGui::Text("CPU p95"); ImGui::NextColumn();
+        ImGui::Text("CPU p99"); ImGui::NextColumn();
+        if (m_ShowGpu)
+        {
+            ImGui::Text("GPU avg"); ImGui::NextColumn();
+            ImGui::Text("GPU p95"); ImGui::NextColumn();
+        }
+        ImGui::Separator();
+
+        for (const auto& section : Profiler::GetSections())
+        {
+            auto cpuStats = Profiler::GetStats(section.CpuHistory);
+
+            ImGui::Indent(section.Depth * 8.0f + 1.0f);
+            ImGui::Text("%s", section.Name.c_str());
+            ImGui::Unindent(section.Depth * 8.0f + 1.0f);
+            ImGui::NextColumn();
+
+            ImGui::Text("%.3f", cpuStats.Average); ImGui::NextColumn();
+            ImGui::Text("%.3f", cpuStats.P50); ImGui::NextColumn();
+            ImGui::Text("%.3f", cpuStats.P95); ImGui::NextColumn();
+            ImGui::Text("%.3f", cpuStats.P99); ImGui::NextColumn();
+
+            if (m_ShowGpu)
+            {
+                auto gpuStats = Profiler::GetStats(section.GpuHistory, true);
+                ImGui::Text("%.3f", gpuStats.Average); ImGui::NextColumn();
+                ImGui::Text("%.3f", gpuStats.P95); ImGui::NextColumn();
+            }
+        }
+
+        ImGui::Columns(1);
+        ImGui::Separator();
+    }
+
+    void ProfilerPanel::RenderHistoryPlot(const char* title, bool gpu)
+    {
+        const auto& sections = Profiler::GetSections();
+
+        float maxValue = 1.0f;
+        for (const auto& section : sections)
+        {
+            const auto& history = gpu ? section.GpuHistory : section.CpuHistory;
+            maxValue = std::max(maxValue, *std::max_element(history.begin(), history.end()));
+        }
+
+        ImPlot::SetNextPlotLimits(0, Profiler::HistorySize, 0, maxValue * 1.1f, ImGuiCond_Always);
+        if (ImPlot::BeginPlot(title, "Frame", "ms", ImVec2(-1, 0)))
+        {
+            int offset = Profiler::GetSampleCount() < Profiler::HistorySize ? 0 : Profiler::GetHistoryOffset();
+            for (const auto& section : sections)
+            {
+                const auto& history = gpu ? section.GpuHistory : section.CpuHistory;
+                ImPlot::PlotLine(section.Name.c_str(), history.data(), Profiler::HistorySize, offset);
+            }
+
+            ImPlot::EndPlot();
+        }
+    }
+}
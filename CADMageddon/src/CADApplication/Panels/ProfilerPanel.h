@@ -0,0 +1,20 @@
+#pragma once
+#include "cadpch.h"
+
+namespace CADMageddon
+{
+    class ProfilerPanel
+    {
+    public:
+        void Render();
+
+    private:
+        void RenderStatsTable();
+        void RenderHistoryPlot(const char* title, bool gpu);
+
+    private:
+        bool m_ShowGpu = true;
+        std::string m_ExportPath = "profile.csv";
+        std::string m_TracePath = "profile.json";
+    };
+}
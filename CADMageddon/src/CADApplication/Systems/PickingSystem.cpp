@@ -6,8 +6,25 @@
 
 namespace CADMageddon
 {
+	template<typename T>
+	static void UpdatePickedSelection(const Scene& scene, uint32_t index, bool isMultiSelect, const std::function<void(bool, Ref<T>)>& callback)
+	{
+		auto object = scene.GetPickedObject<T>(index);
+		if (!object)
+			return;
+
+		//multi select only adds to the selection, a click toggles
+		bool isSelected = isMultiSelect ? true : !object->GetIsSelected();
+		if (isSelected == object->GetIsSelected())
+			return;
+
+		object->SetIsSelected(isSelected);
+		if (callback)
+			callback(isSelected, object);
+	}
+
 	PickingSystem::PickingSystem(Ref<TransformationSystem> transformationSystem)
-		:m_TransformationSystem(transformationSystem)
+		:m_TransformationSystem(transformationSystem), m_PickingReadback(CreateScope<OpenGLPickingReadback>())
 	{
 
 	}
@@ -15,7 +32,7 @@ namespace CADMageddon
 	void PickingSystem::Update(
 		const glm::vec2& mousePosition,
 		const glm::vec2& viewPortSize,
-		const Scene& m_Scene,
+		Scene& m_Scene,
 		const FPSCamera& camera)
 	{
 
@@ -33,16 +50,20 @@ namespace CADMageddon
 			multiSelectEnd = mousePosition;
 		}
 
-		const int pointSize = Renderer::PointSize;
+		if (m_UseGpuPicking)
+		{
+			RequestPicking(mousePosition, mousePosition, false);
+			return;
+		}
 
-		auto points = m_Scene.GetPoints();
+		const int pointSize = Renderer::PointSize;
 
-		for (auto point : points)
+		for (const auto& point : m_Scene.GetPoints())
 		{
 			if (!point->GetIsVisible())
 				continue;
 
-			glm::vec4 worldPosition = point->GetTransform()->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			glm::vec4 worldPosition = point->GetTransform().GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 			auto frustumPosition = camera.GetViewProjectionMatrix() * worldPosition;
 			if (!IsInsideFrustum(frustumPosition))
 			{
@@ -65,7 +86,7 @@ namespace CADMageddon
 				m_OnPointSelectionChanged(point->GetIsSelected(), point);
 		}
 
-		for (auto torus : m_Scene.GetTorus())
+		for (const auto& torus : m_Scene.GetTorus())
 		{
 			glm::vec4 worldPosition = torus->GetTransform()->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 			auto frustumPosition = camera.GetViewProjectionMatrix() * worldPosition;
@@ -112,14 +133,18 @@ namespace CADMageddon
 		multiSelectEnd = mousePosition;
 		RenderPickingBox(viewPortSize);
 
-		auto points = m_Scene.GetPoints();
+		if (m_UseGpuPicking)
+		{
+			RequestPicking(multiSelectStart, multiSelectEnd, true);
+			return;
+		}
 
-		for (auto point : points)
+		for (const auto& point : m_Scene.GetPoints())
 		{
 			if (!point->GetIsVisible())
 				continue;
 
-			glm::vec4 worldPosition = point->GetTransform()->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			glm::vec4 worldPosition = point->GetTransform().GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 			auto frustumPosition = camera.GetViewProjectionMatrix() * worldPosition;
 			if (!IsInsideFrustum(frustumPosition))
 			{
@@ -143,7 +168,7 @@ namespace CADMageddon
 				m_OnPointSelectionChanged(true, point);
 		}
 
-		for (auto torus : m_Scene.GetTorus())
+		for (const auto& torus : m_Scene.GetTorus())
 		{
 			glm::vec4 worldPosition = torus->GetTransform()->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 			auto frustumPosition = camera.GetViewProjectionMatrix() * worldPosition;
@@ -170,6 +195,114 @@ namespace CADMageddon
 		}
 	}
 
+	void PickingSystem::RenderPickingPass(Scene& scene, const Ref<OpenGLFramebuffer>& framebuffer, const FPSCamera& camera)
+	{
+		m_HasPickingRequest = false;
+
+		framebuffer->Bind();
+		Renderer::BeginPickingScene(camera.GetViewProjectionMatrix());
+		scene.RenderPickingIds();
+		Renderer::EndPickingScene();
+		framebuffer->UnBind();
+
+		//a click reads a small square around the cursor so thin lines and small points can still be hit
+		float margin = m_PickingRequest.IsMultiSelect ? 0.0f : (float)Renderer::PointSize;
+		glm::vec2 min = glm::min(m_PickingRequest.Start, m_PickingRequest.End) - margin;
+		glm::vec2 max = glm::max(m_PickingRequest.Start, m_PickingRequest.End) + margin;
+
+		int height = framebuffer->GetSpecification().Height;
+		int x = (int)min.x;
+		int y = height - 1 - (int)max.y;
+		m_PickingReadback->Request(framebuffer, x, y, (int)max.x - x + 1, (int)max.y - (int)min.y + 1);
+		m_ReadbackRequest = m_PickingRequest;
+	}
+
+	void PickingSystem::ResolvePicking(const Scene& scene)
+	{
+		if (!m_PickingReadback->IsReady())
+			return;
+
+		auto ids = m_PickingReadback->Read();
+		int width = m_PickingReadback->GetWidth();
+		int height = m_PickingReadback->GetHeight();
+
+		if (m_ReadbackRequest.IsMultiSelect)
+		{
+			std::unordered_set<uint32_t> pickedIds(ids.begin(), ids.end());
+			for (auto id : pickedIds)
+			{
+				if (id != 0)
+					ApplyPicking(scene, id, true);
+			}
+
+			return;
+		}
+
+		//closest id to the clicked pixel
+		glm::vec2 center = glm::vec2(width - 1, height - 1) / 2.0f;
+		uint32_t closestId = 0;
+		float closestDistance = std::numeric_limits<float>::max();
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				uint32_t id = ids[y * width + x];
+				float distance = glm::distance(glm::vec2(x, y), center);
+				if (id != 0 && distance < closestDistance)
+				{
+					closestId = id;
+					closestDistance = distance;
+				}
+			}
+		}
+
+		if (closestId != 0)
+			ApplyPicking(scene, closestId, false);
+	}
+
+	void PickingSystem::RequestPicking(const glm::vec2& start, const glm::vec2& end, bool isMultiSelect)
+	{
+		m_PickingRequest.Start = start;
+		m_PickingRequest.End = end;
+		m_PickingRequest.IsMultiSelect = isMultiSelect;
+		m_HasPickingRequest = true;
+	}
+
+	void PickingSystem::ApplyPicking(const Scene& scene, uint32_t id, bool isMultiSelect)
+	{
+		uint32_t index = PickingId::GetIndex(id);
+		switch (PickingId::GetType(id))
+		{
+		case PickingType::Point:
+			UpdatePickedSelection<Point>(scene, index, isMultiSelect, m_OnPointSelectionChanged);
+			break;
+		case PickingType::Torus:
+			UpdatePickedSelection<Torus>(scene, index, isMultiSelect, m_OnTorusSelectionChanged);
+			break;
+		case PickingType::BezierC0:
+			UpdatePickedSelection<BezierC0>(scene, index, isMultiSelect, m_OnBezierC0SelectionChanged);
+			break;
+		case PickingType::BSpline:
+			UpdatePickedSelection<BSpline>(scene, index, isMultiSelect, m_OnBSplineSelectionChanged);
+			break;
+		case PickingType::InterpolatedCurve:
+			UpdatePickedSelection<InterpolatedCurve>(scene, index, isMultiSelect, m_OnInterpolatedSelectionChanged);
+			break;
+		case PickingType::BezierPatch:
+			UpdatePickedSelection<BezierPatch>(scene, index, isMultiSelect, m_OnBezierPatchSelectionChanged);
+			break;
+		case PickingType::BSplinePatch:
+			UpdatePickedSelection<BSplinePatch>(scene, index, isMultiSelect, m_OnBSplinePatchSelectionChanged);
+			break;
+		case PickingType::GregoryPatch:
+			UpdatePickedSelection<GregoryPatch>(scene, index, isMultiSelect, m_OnGregoryPatchSelectionChanged);
+			break;
+		case PickingType::IntersectionCurve:
+			UpdatePickedSelection<IntersectionCurve>(scene, index, isMultiSelect, m_OnIntersectionCurveSelectionChanged);
+			break;
+		}
+	}
+
 	void PickingSystem::RenderPickingBox(const glm::vec2& viewPortSize)
 	{
 		glm::vec4 COLOR_SELECTION_BOX_BORDER(0.2, 0.65, 1.0, 1.0);
@@ -182,17 +315,13 @@ namespace CADMageddon
 		Renderer::RenderScreenQuadBorder(ndcStart, ndcEnd, COLOR_SELECTION_BOX_BORDER);
 	}
 
-	void PickingSystem::ClearSelection(const Scene& scene)
+	void PickingSystem::ClearSelection(Scene& scene)
 	{
-		for (auto point : scene.GetPoints())
-		{
-			point->SetIsSelected(false);
-		}
-
-		for (auto torus : scene.GetTorus())
-		{
-			torus->SetIsSelected(false);
-		}
+		//every object type can be picked on the gpu so a new pick starts from an empty selection
+		if (m_UseGpuPicking)
+			scene.ClearSelection();
+		else
+			scene.ClearSelectionOf<Point, Torus>();
 
 		m_OnSelectionCleared();
 	}
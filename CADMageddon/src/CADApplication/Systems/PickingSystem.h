@@ -3,6 +3,7 @@
 #include "cadpch.h"
 #include "Core\Base.h"
 #include "Rendering\Camera.h"
+#include "Rendering\PickingReadback.h"
 
 
 namespace CADMageddon
@@ -11,6 +12,13 @@ namespace CADMageddon
     class Scene;
     class Point;
     class Torus;
+    class BezierC0;
+    class BSpline;
+    class InterpolatedCurve;
+    class BezierPatch;
+    class BSplinePatch;
+    class GregoryPatch;
+    class IntersectionCurve;
 
     //TODO selection box
 
@@ -22,7 +30,7 @@ namespace CADMageddon
         void Update(
             const glm::vec2& mousePosition,
             const glm::vec2& viewPortSize,
-            const Scene& m_Scene,
+            Scene& m_Scene,
             const FPSCamera& camera);
 
         void UpdateMultiSelect(
@@ -42,25 +50,91 @@ namespace CADMageddon
             m_OnTorusSelectionChanged = torusSelectionCallback;
         }
 
+        void SetOnBezierC0SelectionChanged(std::function<void(bool, Ref<BezierC0>)> bezierSelectionCallback)
+        {
+            m_OnBezierC0SelectionChanged = bezierSelectionCallback;
+        }
+
+        void SetOnBSplineSelectionChanged(std::function<void(bool, Ref<BSpline>)> bSplineSelectionCallback)
+        {
+            m_OnBSplineSelectionChanged = bSplineSelectionCallback;
+        }
+
+        void SetOnInterpolatedSelectionChanged(std::function<void(bool, Ref<InterpolatedCurve>)> interpolatedSelectionCallback)
+        {
+            m_OnInterpolatedSelectionChanged = interpolatedSelectionCallback;
+        }
+
+        void SetOnBezierPatchSelectionChanged(std::function<void(bool, Ref<BezierPatch>)> bezierPatchSelectionCallback)
+        {
+            m_OnBezierPatchSelectionChanged = bezierPatchSelectionCallback;
+        }
+
+        void SetOnBSplinePatchSelectionChanged(std::function<void(bool, Ref<BSplinePatch>)> bSplinePatchSelectionCallback)
+        {
+            m_OnBSplinePatchSelectionChanged = bSplinePatchSelectionCallback;
+        }
+
+        void SetOnGregoryPatchSelectionChanged(std::function<void(bool, Ref<GregoryPatch>)> gregoryPatchSelectionCallback)
+        {
+            m_OnGregoryPatchSelectionChanged = gregoryPatchSelectionCallback;
+        }
+
+        void SetOnIntersectionCurveSelectionChanged(std::function<void(bool, Ref<IntersectionCurve>)> intersectionCurveSelectionCallback)
+        {
+            m_OnIntersectionCurveSelectionChanged = intersectionCurveSelectionCallback;
+        }
+
         void SetOnSelectionCleared(std::function<void()> selectionClearedCallback)
         {
             m_OnSelectionCleared = selectionClearedCallback;
         }
 
+        //gpu picking renders object ids into the framebuffer's picking attachment and reads back only the picked pixels,
+        //it picks every object type and its cost does not depend on the scene size
+        bool GetUseGpuPicking() const { return m_UseGpuPicking; }
+        void SetUseGpuPicking(bool useGpuPicking) { m_UseGpuPicking = useGpuPicking; }
+
+        bool HasPickingRequest() const { return m_HasPickingRequest; }
+        void RenderPickingPass(Scene& scene, const Ref<OpenGLFramebuffer>& framebuffer, const FPSCamera& camera);
+        void ResolvePicking(const Scene& scene);
+
     private:
+        struct PickingRequest
+        {
+            glm::vec2 Start;
+            glm::vec2 End;
+            bool IsMultiSelect = false;
+        };
+
         void RenderPickingBox(const glm::vec2& viewPortSize);
+        void RequestPicking(const glm::vec2& start, const glm::vec2& end, bool isMultiSelect);
+        void ApplyPicking(const Scene& scene, uint32_t id, bool isMultiSelect);
 
     private:
         std::function<void(bool, Ref<Point>)> m_OnPointSelectionChanged;
         std::function<void(bool, Ref<Torus>)> m_OnTorusSelectionChanged;
+        std::function<void(bool, Ref<BezierC0>)> m_OnBezierC0SelectionChanged;
+        std::function<void(bool, Ref<BSpline>)> m_OnBSplineSelectionChanged;
+        std::function<void(bool, Ref<InterpolatedCurve>)> m_OnInterpolatedSelectionChanged;
+        std::function<void(bool, Ref<BezierPatch>)> m_OnBezierPatchSelectionChanged;
+        std::function<void(bool, Ref<BSplinePatch>)> m_OnBSplinePatchSelectionChanged;
+        std::function<void(bool, Ref<GregoryPatch>)> m_OnGregoryPatchSelectionChanged;
+        std::function<void(bool, Ref<IntersectionCurve>)> m_OnIntersectionCurveSelectionChanged;
         std::function<void()> m_OnSelectionCleared;
 
+        bool m_UseGpuPicking = false;
+        bool m_HasPickingRequest = false;
+        PickingRequest m_PickingRequest;
+        PickingRequest m_ReadbackRequest;
+        Scope<OpenGLPickingReadback> m_PickingReadback;
+
 
         glm::vec2 multiSelectStart;
         glm::vec2 multiSelectEnd;
         bool m_IsMultiSelect = false;
         Ref<TransformationSystem> m_TransformationSystem;
-        void ClearSelection(const Scene& scene);
+        void ClearSelection(Scene& scene);
         bool IsInsideFrustum(const glm::vec4& position);
         bool IsInsidePickingArea(const glm::vec2& position, const glm::vec2& mousePosition, const float pickingDistance);
         bool IsInsidePickingBox(const glm::vec2& selectionBoxStart, const glm::vec2& selectionBoxEnd, const glm::vec2& position);
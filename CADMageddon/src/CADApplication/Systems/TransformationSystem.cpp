@@ -21,6 +21,7 @@ namespace CADMageddon
 
     void TransformationSystem::Update(Ref<Scene> scene, FPSCamera& camera, glm::vec2 ndcMousePosition)
     {
+        RemoveDeleted();
         if (m_SelectedEntities.empty())
         {
             return;
@@ -49,64 +50,103 @@ namespace CADMageddon
 
     void TransformationSystem::RenderImGui()
     {
+        RemoveDeleted();
         auto& transform = GetTransformToModify();
 
-        auto position = transform.Translation;
+        auto position = transform.GetTranslation();
         if (ImGui::DragFloat3("Position", &position.x, 0.1f))
         {
-            transform.Translation = position;
+            transform.SetTranslation(position);
             if (m_TransformationOrigin == TransformationOrigin::Cursor)
             {
                 RecalculateParentAndChildrenTransform();
             }
         }
 
-        auto rotation = transform.Rotation;
+        auto rotation = transform.GetRotation();
         if (ImGui::DragFloat3("Rotation", &rotation.x))
         {
-            transform.Rotation = rotation;
+            transform.SetRotation(rotation);
         }
 
-        auto scale = transform.Scale;
+        auto scale = transform.GetScale();
         if (ImGui::DragFloat3("Scale", &scale.x, 0.1f))
         {
-            transform.Scale = scale;
+            transform.SetScale(scale);
         }
     }
 
     void TransformationSystem::AddToSelected(Ref<Transform> entity)
     {
-        m_SelectedEntities.push_back(entity);
+        m_SelectedEntities.push_back({ PointHandle(), entity });
+        RecalculateParentAndChildrenTransform();
+    }
+
+    void TransformationSystem::AddToSelected(PointHandle point)
+    {
+        if (!PointStore::Get().IsAlive(point))
+            return;
+
+        m_SelectedEntities.push_back({ point, nullptr });
         RecalculateParentAndChildrenTransform();
     }
 
     void TransformationSystem::RemoveFromSelected(Ref<Transform> entity)
     {
-        auto it = std::find(m_SelectedEntities.begin(), m_SelectedEntities.end(), entity);
-        if (it != m_SelectedEntities.end())
-        {
-            UnAssignParentTransform(**it);
-            m_SelectedEntities.erase(it);
-            RecalculateParentAndChildrenTransform();
-        }
+        auto it = std::find_if(m_SelectedEntities.begin(), m_SelectedEntities.end(), [&entity](const SelectedTransform& selected) { return selected.Owned == entity; });
+        EraseSelected(it);
+    }
+
+    void TransformationSystem::RemoveFromSelected(PointHandle point)
+    {
+        auto it = std::find_if(m_SelectedEntities.begin(), m_SelectedEntities.end(), [point](const SelectedTransform& selected) { return !selected.Owned && selected.Point == point; });
+        EraseSelected(it);
+    }
+
+    void TransformationSystem::EraseSelected(std::vector<SelectedTransform>::iterator it)
+    {
+        if (it == m_SelectedEntities.end())
+            return;
+
+        //the slot of a deleted point may already belong to another point, it is not touched
+        if (it->Owned || PointStore::Get().IsAlive(it->Point))
+            UnAssignParentTransform(GetTransform(*it));
+
+        m_SelectedEntities.erase(it);
+        RemoveDeleted();
+        RecalculateParentAndChildrenTransform();
     }
 
     void TransformationSystem::ClearSelection()
     {
-        for (auto selected : m_SelectedEntities)
+        RemoveDeleted();
+        for (const auto& selected : m_SelectedEntities)
         {
-            UnAssignParentTransform(*selected);
+            UnAssignParentTransform(GetTransform(selected));
         }
 
         m_SelectedEntities.clear();
     }
 
+    Transform& TransformationSystem::GetTransform(const SelectedTransform& selected)
+    {
+        return selected.Owned ? *selected.Owned : PointStore::Get().GetTransform(selected.Point);
+    }
+
+    void TransformationSystem::RemoveDeleted()
+    {
+        auto& store = PointStore::Get();
+        m_SelectedEntities.erase(std::remove_if(m_SelectedEntities.begin(), m_SelectedEntities.end(),
+            [&store](const SelectedTransform& selected) { return !selected.Owned && !store.IsAlive(selected.Point); }),
+            m_SelectedEntities.end());
+    }
+
     Transform& TransformationSystem::GetTransformToModify()
     {
 
         if (m_SelectedEntities.size() == 1 && m_TransformationOrigin == TransformationOrigin::Center)
         {
-            return *m_SelectedEntities[0];
+            return GetTransform(m_SelectedEntities[0]);
         }
         else
         {
@@ -116,28 +156,29 @@ namespace CADMageddon
 
     void TransformationSystem::AssignParentTransform(Transform& transform)
     {
-        transform.Parent = m_TransformationParent;
-        transform.Translation -= m_TransformationParent->Translation;
+        transform.SetParent(m_TransformationParent);
+        transform.SetTranslation(transform.GetTranslation() - m_TransformationParent->GetTranslation());
 
     }
 
     void TransformationSystem::UnAssignParentTransform(Transform& transform)
     {
         glm::vec3 parentTranslation = transform.GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-        transform.Translation = parentTranslation;
-        transform.Parent = nullptr;
+        transform.SetTranslation(parentTranslation);
+        transform.SetParent(nullptr);
     }
 
     void TransformationSystem::RecalculateParentAndChildrenTransform()
     {
+        RemoveDeleted();
         if (m_SelectedEntities.empty())
         {
             return;
         }
 
-        for (auto selected : m_SelectedEntities)
+        for (const auto& selected : m_SelectedEntities)
         {
-            UnAssignParentTransform(*selected);
+            UnAssignParentTransform(GetTransform(selected));
         }
 
         if (m_TransformationOrigin == TransformationOrigin::Center && m_SelectedEntities.size() == 1)
@@ -146,13 +187,13 @@ namespace CADMageddon
         }
 
         auto center = GetTransformCenter();
-        m_TransformationParent->Translation = center;
-        m_TransformationParent->Rotation = glm::vec3(0.0f, 0.0f, 0.0f);
-        m_TransformationParent->Scale = glm::vec3(1.0f, 1.0f, 1.0f);
+        m_TransformationParent->SetTranslation(center);
+        m_TransformationParent->SetRotation(glm::vec3(0.0f, 0.0f, 0.0f));
+        m_TransformationParent->SetScale(glm::vec3(1.0f, 1.0f, 1.0f));
 
-        for (auto selected : m_SelectedEntities)
+        for (const auto& selected : m_SelectedEntities)
         {
-            AssignParentTransform(*selected);
+            AssignParentTransform(GetTransform(selected));
         }
     }
 
@@ -166,10 +207,10 @@ namespace CADMageddon
         int count = 0;
         glm::vec3 center = { 0.0f,0.0f,0.0f };
 
-        for (auto selected : m_SelectedEntities)
+        for (const auto& selected : m_SelectedEntities)
         {
 
-            glm::vec3 position = selected->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            glm::vec3 position = GetTransform(selected).GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
             center += position;
             count++;
         }
@@ -30,10 +30,12 @@ namespace CADMageddon
         void RenderImGui();
 
         void AddToSelected(Ref<Transform> transform);
+        void AddToSelected(PointHandle point);
         void RemoveFromSelected(Ref<Transform> transform);
+        void RemoveFromSelected(PointHandle point);
         void ClearSelection();
 
-        glm::vec3 GetTransformationCenter() const { return m_TransformationParent->Translation; }
+        glm::vec3 GetTransformationCenter() const { return m_TransformationParent->GetTranslation(); }
         unsigned int GetCount() const { return m_SelectedEntities.size(); }
 
         TransformationMode GetTransformationMode() const { return m_TransformationMode; }
@@ -43,6 +45,18 @@ namespace CADMageddon
         void SetTransformationOrigin(TransformationOrigin origin) { m_TransformationOrigin = origin; RecalculateParentAndChildrenTransform(); }
 
     private:
+        //points are kept by handle and looked up in the PointStore, a deleted point no longer resolves
+        //toruses own their transform and are kept by it
+        struct SelectedTransform
+        {
+            PointHandle Point;
+            Ref<Transform> Owned;
+        };
+
+        Transform& GetTransform(const SelectedTransform& selected);
+        void RemoveDeleted();
+        void EraseSelected(std::vector<SelectedTransform>::iterator it);
+
         Transform& GetTransformToModify();
         void AssignParentTransform(Transform& transform);
         void UnAssignParentTransform(Transform& transform);
@@ -53,7 +67,7 @@ namespace CADMageddon
     private:
         TransformationMode m_TransformationMode;
         TransformationOrigin m_TransformationOrigin;
-        std::vector<Ref<Transform>> m_SelectedEntities;
+        std::vector<SelectedTransform> m_SelectedEntities;
 
         Ref<Cursor3D> m_Cursor;
         Ref<Transform> m_TransformationParent;
@@ -3,6 +3,7 @@
 
 #include "Base.h"
 #include "Timestep.h"
+#include "Profiler.h"
 
 #include "CADApplication\EditorLayer.h"
 #include "Rendering\Renderer.h"
@@ -14,29 +15,53 @@ namespace CADMageddon
     Application::Application()
     {
         m_Instance = this;
+        m_MainThreadId = std::this_thread::get_id();
         m_window = CreateScope<Window>();
     }
 
     Application::~Application()
     {
-
+        Profiler::ShutDown();
     }
 
-    void Application::Init()
+    bool Application::Init()
     {
         Logger::Init();
         WindowProps windowData("CADMageddon");
 
-        m_window->Init(windowData);
+        if (!m_window->Init(windowData))
+            return false;
+
         m_window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
 
         Renderer::Init();
 
         PushLayer(new EditorLayer("EditorLayer"));
+        return true;
+    }
+
+    bool Application::RunBenchmark(const BenchmarkSettings& settings)
+    {
+        Logger::Init();
+        WindowProps windowData("CADMageddon benchmark", settings.Width, settings.Height, settings.Headless);
+
+        if (!m_window->Init(windowData))
+            return false;
+
+        m_window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
+        m_window->SetVSync(false);
+
+        Renderer::Init();
+
+        Benchmark benchmark(settings);
+        return benchmark.Run();
     }
 
     void Application::OnEvent(Event& e)
     {
+        //any input, resize or expose may change what is on screen
+        RequestRedraw();
+
         EventDispatcher dispatcher(e);
         dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(Application::OnWindowClose));
         dispatcher.Dispatch<WindowResizeEvent>(BIND_EVENT_FN(Application::OnWindowResize));
@@ -61,19 +86,58 @@ namespace CADMageddon
         layer->OnAttach();
     }
 
+    void Application::RequestRedraw(int frameCount)
+    {
+        int pendingFrames = m_PendingFrames.load();
+        while (pendingFrames < frameCount && !m_PendingFrames.compare_exchange_weak(pendingFrames, frameCount))
+        {
+        }
+
+        //the main loop may be blocked waiting for events, background jobs have to wake it up
+        if (std::this_thread::get_id() != m_MainThreadId)
+            glfwPostEmptyEvent();
+    }
+
     void Application::Run()
     {
+        bool wasIdle = false;
 
         while (m_Running)
         {
+            bool isIdle = m_Minimized || (!m_ContinuousRendering && m_PendingFrames.load() == 0);
+            if (isIdle)
+                m_window->WaitEvents(IdleTimeout);
+            else
+                m_window->PollEvents();
+
+            if (!m_ContinuousRendering)
+            {
+                //a timeout or an event that did not request a frame, keep waiting
+                if (m_PendingFrames.load() == 0)
+                {
+                    wasIdle = true;
+                    continue;
+                }
+
+                m_PendingFrames--;
+            }
+
+            Profiler::BeginFrame();
 
             float time = (float)glfwGetTime();
             Timestep timestep = time - m_LastFrameTime;
             m_LastFrameTime = time;
 
+            if (wasIdle)
+            {
+                timestep = std::min(timestep.getSeconds(), MaxIdleTimestep);
+                wasIdle = false;
+            }
+
             if (!m_Minimized)
             {
                 {
+                    CDM_PROFILE_SCOPE("Layers");
                     for (Layer* layer : m_LayerStack)
                         layer->OnUpdate(timestep);
                 }
@@ -88,7 +152,12 @@ namespace CADMageddon
                 m_ImGuiLayer->End();*/
             }
 
-            m_window->OnUpdate();
+            {
+                CDM_PROFILE_SCOPE("Window::SwapBuffers");
+                m_window->SwapBuffers();
+            }
+
+            Profiler::EndFrame();
         }
     }
 
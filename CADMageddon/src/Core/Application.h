@@ -3,6 +3,9 @@
 #include "LayerStack.h"
 #include "Events\Event.h"
 #include "Events\ApplicationEvent.h"
+#include "CADApplication\Benchmark.h"
+#include <atomic>
+#include <thread>
 
 namespace CADMageddon
 {
@@ -17,25 +20,46 @@ namespace CADMageddon
         void PushLayer(Layer* layer);
         void PushOverlay(Layer* layer);
 
-        void Init();
+        //false when there is no window to run in, the application has to exit then
+        bool Init();
         void Run();
 
+        //renders the benchmark scene without the editor, returns false when it could not run
+        bool RunBenchmark(const BenchmarkSettings& settings);
+
         void Close();
 
         static Application& Get() { return *m_Instance; }
 
         Window& GetMainWindow() { return *m_window; }
 
+        //frames are only rendered when something asked for them, safe to call from any thread
+        void RequestRedraw(int frameCount = RedrawFrameCount);
+
+        bool GetContinuousRendering() const { return m_ContinuousRendering; }
+        void SetContinuousRendering(bool continuousRendering) { m_ContinuousRendering = continuousRendering; }
+
     private:
         bool OnWindowClose(WindowCloseEvent& e);
         bool OnWindowResize(WindowResizeEvent& e);
 
         static Application* m_Instance;
 
+        //ImGui needs a few frames after an input for hover and layout state to settle
+        static constexpr int RedrawFrameCount = 3;
+        //idle waits still wake up this often so ImGui timers like the text cursor blink keep going
+        static constexpr double IdleTimeout = 0.5;
+        //the first frame after an idle period would otherwise see the whole idle time as its timestep
+        static constexpr float MaxIdleTimestep = 1.0f / 30.0f;
+
         bool m_Running = true;
         bool m_Minimized = false;
         float m_LastFrameTime = 0.0f;
 
+        bool m_ContinuousRendering = false;
+        std::atomic<int> m_PendingFrames = RedrawFrameCount;
+        std::thread::id m_MainThreadId;
+
         std::unique_ptr<Window> m_window;
 
         LayerStack m_LayerStack;
@@ -0,0 +1,302 @@
+#include "Profiler.h"
+#include <glad\glad.h>
+#include <fstream>
+#include <iomanip>
+
+namespace CADMageddon
+{
+    bool Profiler::s_IsEnabled = false;
+    bool Profiler::s_EnableRequested = false;
+    int Profiler::s_FrameIndex = 0;
+    int Profiler::s_Depth = 0;
+
+    std::vector<ProfileSection> Profiler::s_Sections;
+    std::unordered_map<std::string, int> Profiler::s_SectionIndices;
+    Profiler::FrameQueries Profiler::s_FrameQueries[QueryLatency];
+
+    std::vector<uint8_t> Profiler::s_GpuValid(Profiler::HistorySize, 0);
+    std::vector<std::vector<ProfileSpan>> Profiler::s_CpuSpans(Profiler::HistorySize);
+    std::vector<std::vector<ProfileSpan>> Profiler::s_GpuSpans(Profiler::HistorySize);
+    std::chrono::high_resolution_clock::time_point Profiler::s_CpuEpoch;
+    int64_t Profiler::s_GpuEpoch = 0;
+
+    static int s_FrameSection = Profiler::RegisterSection("Frame");
+
+    int Profiler::RegisterSection(const std::string& name)
+    {
+        auto it = s_SectionIndices.find(name);
+        if (it != s_SectionIndices.end())
+            return it->second;
+
+        ProfileSection section;
+        section.Name = name;
+        section.CpuHistory.resize(HistorySize, 0.0f);
+        section.GpuHistory.resize(HistorySize, 0.0f);
+
+        s_Sections.push_back(section);
+        s_SectionIndices.insert({ name, (int)s_Sections.size() - 1 });
+
+        return s_Sections.size() - 1;
+    }
+
+    void Profiler::BeginFrame()
+    {
+        if (s_IsEnabled != s_EnableRequested)
+        {
+            s_IsEnabled = s_EnableRequested;
+            if (!s_IsEnabled)
+            {
+                for (auto& frameQueries : s_FrameQueries)
+                    frameQueries.IsPending = false;
+            }
+            else
+            {
+                GLint64 gpuNow = 0;
+                glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+                s_GpuEpoch = gpuNow;
+                s_CpuEpoch = std::chrono::high_resolution_clock::now();
+            }
+        }
+
+        if (!s_IsEnabled)
+            return;
+
+        auto& frameQueries = s_FrameQueries[s_FrameIndex % QueryLatency];
+        if (frameQueries.IsPending)
+            ResolveQueries(frameQueries);
+
+        frameQueries.UsedQueries = 0;
+        frameQueries.Ranges.clear();
+        frameQueries.HistoryIndex = s_FrameIndex % HistorySize;
+        frameQueries.IsPending = true;
+
+        s_GpuValid[frameQueries.HistoryIndex] = 0;
+        s_CpuSpans[frameQueries.HistoryIndex].clear();
+        s_GpuSpans[frameQueries.HistoryIndex].clear();
+        for (auto& section : s_Sections)
+        {
+            section.CpuFrameTime = 0.0f;
+            section.GpuHistory[frameQueries.HistoryIndex] = 0.0f;
+        }
+
+        BeginSection(s_FrameSection);
+    }
+
+    void Profiler::EndFrame()
+    {
+        if (!s_IsEnabled)
+            return;
+
+        EndSection(s_FrameSection);
+
+        int historyIndex = s_FrameIndex % HistorySize;
+        for (auto& section : s_Sections)
+            section.CpuHistory[historyIndex] = section.CpuFrameTime;
+
+        s_FrameIndex++;
+    }
+
+    void Profiler::ShutDown()
+    {
+        for (auto& frameQueries : s_FrameQueries)
+        {
+            if (!frameQueries.Queries.empty())
+                glDeleteQueries(frameQueries.Queries.size(), frameQueries.Queries.data());
+
+            frameQueries.Queries.clear();
+            frameQueries.Ranges.clear();
+            frameQueries.IsPending = false;
+        }
+    }
+
+    void Profiler::BeginSection(int section)
+    {
+        if (!s_IsEnabled)
+            return;
+
+        auto& profileSection = s_Sections[section];
+        profileSection.Depth = s_Depth++;
+        profileSection.GpuStartQuery = AcquireQuery();
+        profileSection.CpuStart = std::chrono::high_resolution_clock::now();
+    }
+
+    void Profiler::EndSection(int section)
+    {
+        if (!s_IsEnabled)
+            return;
+
+        auto& profileSection = s_Sections[section];
+        auto cpuEnd = std::chrono::high_resolution_clock::now();
+        profileSection.CpuFrameTime += std::chrono::duration<float, std::milli>(cpuEnd - profileSection.CpuStart).count();
+
+        double start = std::chrono::duration<double, std::micro>(profileSection.CpuStart - s_CpuEpoch).count();
+        double duration = std::chrono::duration<double, std::micro>(cpuEnd - profileSection.CpuStart).count();
+        s_CpuSpans[s_FrameIndex % HistorySize].push_back({ section, start, duration });
+
+        auto& frameQueries = s_FrameQueries[s_FrameIndex % QueryLatency];
+        frameQueries.Ranges.push_back({ section, profileSection.GpuStartQuery, AcquireQuery() });
+
+        s_Depth--;
+    }
+
+    ProfileStats Profiler::GetStats(const std::vector<float>& history, bool gpu)
+    {
+        ProfileStats stats;
+
+        //while the history is filling up the recorded samples are the first GetSampleCount() entries
+        std::vector<float> samples;
+        samples.reserve(GetSampleCount());
+        for (int i = 0; i < GetSampleCount(); i++)
+        {
+            if (!gpu || s_GpuValid[i])
+                samples.push_back(history[i]);
+        }
+
+        int sampleCount = samples.size();
+        if (sampleCount == 0)
+            return stats;
+
+        std::sort(samples.begin(), samples.end());
+
+        float sum = 0.0f;
+        for (auto sample : samples)
+            sum += sample;
+
+        auto percentile = [&samples](float p) { return samples[std::min((int)(p * samples.size()), (int)samples.size() - 1)]; };
+
+        stats.Average = sum / sampleCount;
+        stats.P50 = percentile(0.50f);
+        stats.P95 = percentile(0.95f);
+        stats.P99 = percentile(0.99f);
+        stats.Max = samples.back();
+
+        return stats;
+    }
+
+    bool Profiler::ExportCsv(const std::string& filePath)
+    {
+        std::ofstream file(filePath);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Could not open {0} for profiler export", filePath);
+            return false;
+        }
+
+        file << "frame";
+        for (const auto& section : s_Sections)
+            file << "," << section.Name << " cpu ms," << section.Name << " gpu ms";
+        file << "\n";
+
+        int sampleCount = GetSampleCount();
+        int firstFrame = s_FrameIndex - sampleCount;
+        for (int frame = firstFrame; frame < s_FrameIndex; frame++)
+        {
+            int historyIndex = frame % HistorySize;
+            file << frame;
+            for (const auto& section : s_Sections)
+            {
+                file << "," << section.CpuHistory[historyIndex] << ",";
+                if (s_GpuValid[historyIndex])
+                    file << section.GpuHistory[historyIndex];
+            }
+            file << "\n";
+        }
+
+        LOG_INFO("Exported {0} profiled frames to {1}", sampleCount, filePath);
+        return true;
+    }
+
+    static std::string EscapeJson(const std::string& text)
+    {
+        std::string escaped;
+        for (auto c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+
+        return escaped;
+    }
+
+    bool Profiler::ExportTrace(const std::string& filePath)
+    {
+        std::ofstream file(filePath);
+        if (!file.is_open())
+        {
+            LOG_ERROR("Could not open {0} for profiler export", filePath);
+            return false;
+        }
+
+        //complete events, the viewer nests them by time, cpu and gpu get a track each
+        file << std::fixed << std::setprecision(3);
+        file << "{\"traceEvents\":[\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+        int sampleCount = GetSampleCount();
+        int firstFrame = s_FrameIndex - sampleCount;
+        for (int frame = firstFrame; frame < s_FrameIndex; frame++)
+        {
+            int historyIndex = frame % HistorySize;
+            for (int track = 0; track < 2; track++)
+            {
+                const auto& spans = track == 0 ? s_CpuSpans[historyIndex] : s_GpuSpans[historyIndex];
+                for (const auto& span : spans)
+                {
+                    file << ",\n{\"name\":\"" << EscapeJson(s_Sections[span.Section].Name)
+                        << "\",\"cat\":\"" << (track == 0 ? "cpu" : "gpu")
+                        << "\",\"ph\":\"X\",\"ts\":" << span.Start << ",\"dur\":" << span.Duration
+                        << ",\"pid\":0,\"tid\":" << track << ",\"args\":{\"frame\":" << frame << "}}";
+                }
+            }
+        }
+
+        file << "\n]}\n";
+
+        LOG_INFO("Exported a trace of {0} profiled frames to {1}", sampleCount, filePath);
+        return true;
+    }
+
+    int Profiler::AcquireQuery()
+    {
+        auto& frameQueries = s_FrameQueries[s_FrameIndex % QueryLatency];
+        if (frameQueries.UsedQueries == frameQueries.Queries.size())
+        {
+            unsigned int query;
+            glGenQueries(1, &query);
+            frameQueries.Queries.push_back(query);
+        }
+
+        int index = frameQueries.UsedQueries++;
+        glQueryCounter(frameQueries.Queries[index], GL_TIMESTAMP);
+        return index;
+    }
+
+    void Profiler::ResolveQueries(FrameQueries& frameQueries)
+    {
+        frameQueries.IsPending = false;
+        if (frameQueries.Ranges.empty())
+            return;
+
+        //queries complete in order, the last one being ready means the whole frame is
+        //a frame still not ready after QueryLatency frames is dropped and stays out of the stats
+        int available = 0;
+        glGetQueryObjectiv(frameQueries.Queries[frameQueries.UsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+
+        for (const auto& range : frameQueries.Ranges)
+        {
+            GLuint64 start = 0;
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(frameQueries.Queries[range.StartQuery], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(frameQueries.Queries[range.EndQuery], GL_QUERY_RESULT, &end);
+
+            s_Sections[range.Section].GpuHistory[frameQueries.HistoryIndex] += (end - start) / 1000000.0f;
+            s_GpuSpans[frameQueries.HistoryIndex].push_back({ range.Section, ((int64_t)start - s_GpuEpoch) / 1000.0, (end - start) / 1000.0 });
+        }
+
+        s_GpuValid[frameQueries.HistoryIndex] = 1;
+    }
+}
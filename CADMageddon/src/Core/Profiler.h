@@ -0,0 +1,121 @@
+#pragma once
+#include "cadpch.h"
+#include <chrono>
+
+namespace CADMageddon
+{
+    struct ProfileStats
+    {
+        float Average = 0.0f;
+        float P50 = 0.0f;
+        float P95 = 0.0f;
+        float P99 = 0.0f;
+        float Max = 0.0f;
+    };
+
+    //one timed run of a section, in microseconds since the profiler was enabled
+    struct ProfileSpan
+    {
+        int Section;
+        double Start;
+        double Duration;
+    };
+
+    struct ProfileSection
+    {
+        std::string Name;
+        int Depth = 0;
+
+        //rolling history in milliseconds, indexed by frame % Profiler::HistorySize
+        std::vector<float> CpuHistory;
+        std::vector<float> GpuHistory;
+
+        float CpuFrameTime = 0.0f;
+        std::chrono::high_resolution_clock::time_point CpuStart;
+        int GpuStartQuery = -1;
+    };
+
+    class Profiler
+    {
+    public:
+        static constexpr int HistorySize = 300;
+
+        //timestamp queries are read back this many frames later so the readback never waits for the GPU
+        static constexpr int QueryLatency = 3;
+
+        static bool GetIsEnabled() { return s_IsEnabled; }
+        static void SetIsEnabled(bool isEnabled) { s_EnableRequested = isEnabled; }
+
+        static void BeginFrame();
+        static void EndFrame();
+        static void ShutDown();
+
+        static int RegisterSection(const std::string& name);
+        static void BeginSection(int section);
+        static void EndSection(int section);
+
+        static const std::vector<ProfileSection>& GetSections() { return s_Sections; }
+        static int GetHistoryOffset() { return s_FrameIndex % HistorySize; }
+        static int GetSampleCount() { return std::min(s_FrameIndex, HistorySize); }
+
+        //gpu samples of frames whose queries were not read back yet, or never, are left out
+        static ProfileStats GetStats(const std::vector<float>& history, bool gpu = false);
+
+        static bool ExportCsv(const std::string& filePath);
+        //chrome://tracing / Perfetto json with the cpu and gpu spans of the frames in the history
+        static bool ExportTrace(const std::string& filePath);
+
+    private:
+        struct GpuRange
+        {
+            int Section;
+            int StartQuery;
+            int EndQuery;
+        };
+
+        struct FrameQueries
+        {
+            std::vector<unsigned int> Queries;
+            std::vector<GpuRange> Ranges;
+            int UsedQueries = 0;
+            int HistoryIndex = 0;
+            bool IsPending = false;
+        };
+
+        static int AcquireQuery();
+        static void ResolveQueries(FrameQueries& frameQueries);
+
+    private:
+        static bool s_IsEnabled;
+        static bool s_EnableRequested;
+        static int s_FrameIndex;
+        static int s_Depth;
+
+        static std::vector<ProfileSection> s_Sections;
+        static std::unordered_map<std::string, int> s_SectionIndices;
+        static FrameQueries s_FrameQueries[QueryLatency];
+
+        //per history entry, the gpu timestamps are mapped onto the cpu clock through the pair taken when enabling
+        static std::vector<uint8_t> s_GpuValid;
+        static std::vector<std::vector<ProfileSpan>> s_CpuSpans;
+        static std::vector<std::vector<ProfileSpan>> s_GpuSpans;
+        static std::chrono::high_resolution_clock::time_point s_CpuEpoch;
+        static int64_t s_GpuEpoch;
+    };
+
+    class ProfileScope
+    {
+    public:
+        ProfileScope(int section) : m_Section(section) { Profiler::BeginSection(m_Section); }
+        ~ProfileScope() { Profiler::EndSection(m_Section); }
+
+    private:
+        int m_Section;
+    };
+}
+
+#define CDM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CDM_PROFILE_CONCAT(a, b) CDM_PROFILE_CONCAT_IMPL(a, b)
+#define CDM_PROFILE_SCOPE(name) \
+    static const int CDM_PROFILE_CONCAT(profileSection, __LINE__) = ::CADMageddon::Profiler::RegisterSection(name); \
+    ::CADMageddon::ProfileScope CDM_PROFILE_CONCAT(profileScope, __LINE__)(CDM_PROFILE_CONCAT(profileSection, __LINE__))
@@ -25,7 +25,7 @@ namespace CADMageddon
         Shutdown();
     }
 
-    void Window::Init(const WindowProps& props)
+    bool Window::Init(const WindowProps& props)
     {
         m_Data.Title = props.m_title;
         m_Data.Width = props.m_width;
@@ -33,10 +33,16 @@ namespace CADMageddon
 
         if (m_GLFWWindowCount == 0)
         {
+#ifdef GLFW_PLATFORM_NULL
+            //the null platform needs no display server at all
+            if (props.m_headless)
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
             int success = glfwInit();
             if (!success)
             {
                 LOG_ERROR("Could not initialize GLFW");
+                return false;
             }
 
             glfwSetErrorCallback(GLFWErrorCallback);
@@ -47,11 +53,30 @@ namespace CADMageddon
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
         glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE); //TODO: conditional enable
 
+        if (props.m_headless)
+        {
+            //OSMesa renders into client memory, with Mesa's llvmpipe driver this runs entirely on the CPU
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        }
+
         m_Window = glfwCreateWindow((int)m_Data.Width, (int)m_Data.Height, m_Data.Title.c_str(), nullptr, nullptr);
+        if (!m_Window)
+        {
+            LOG_ERROR(props.m_headless ? "Could not create headless OpenGL context" : "Could not create window");
+            if (m_GLFWWindowCount == 0)
+                glfwTerminate();
+            return false;
+        }
         ++m_GLFWWindowCount;
 
         m_Context = CreateScope<OpenGLContext>(m_Window);
-        m_Context->Init();
+        if (!m_Context->Init())
+        {
+            m_Context.reset();
+            Shutdown();
+            return false;
+        }
 
         glfwSetWindowUserPointer(m_Window, &m_Data);
         SetVSync(true);
@@ -66,6 +91,13 @@ namespace CADMageddon
                 data.EventCallback(event);
             });
 
+        glfwSetWindowRefreshCallback(m_Window, [](GLFWwindow* window)
+            {
+                WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+                AppRenderEvent event;
+                data.EventCallback(event);
+            });
+
         glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
             {
                 WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
@@ -144,12 +176,17 @@ namespace CADMageddon
                 MouseMovedEvent event((float)xPos, (float)yPos);
                 data.EventCallback(event);
             });
+
+        return true;
     }
 
     void Window::Shutdown()
     {
+        if (!m_Window)
+            return;
 
         glfwDestroyWindow(m_Window);
+        m_Window = nullptr;
         --m_GLFWWindowCount;
 
         if (m_GLFWWindowCount == 0)
@@ -158,9 +195,18 @@ namespace CADMageddon
         }
     }
 
-    void Window::OnUpdate()
+    void Window::PollEvents()
     {
         glfwPollEvents();
+    }
+
+    void Window::WaitEvents(double timeout)
+    {
+        glfwWaitEventsTimeout(timeout);
+    }
+
+    void Window::SwapBuffers()
+    {
         m_Context->SwapBuffers();
     }
 
@@ -20,7 +20,10 @@ namespace CADMageddon
         Window();
         virtual ~Window();
 
-        void OnUpdate();
+        void PollEvents();
+        //blocks until an event arrives, glfwPostEmptyEvent or the timeout wakes it up
+        void WaitEvents(double timeout);
+        void SwapBuffers();
 
         unsigned int GetWidth() const { return m_Data.Width; }
         unsigned int GetHeight() const { return m_Data.Height; }
@@ -32,11 +35,12 @@ namespace CADMageddon
 
         virtual void* GetNativeWindow() const { return m_Window; }
 
-        virtual void Init(const WindowProps& props);
+        //false when the window or its context could not be created, nothing is left open then
+        virtual bool Init(const WindowProps& props);
         virtual void Shutdown();
     
     private:
-        GLFWwindow* m_Window;
+        GLFWwindow* m_Window = nullptr;
         Scope<OpenGLContext> m_Context;
 
         struct WindowData
@@ -5,11 +5,14 @@ namespace CADMageddon
 {
     struct WindowProps
     {
-        WindowProps(std::string title = "Lear OpenGl", int width = 1280, int height = 780)
-            :m_title(title), m_width(width), m_height(height) {}
+        WindowProps(std::string title = "Lear OpenGl", int width = 1280, int height = 780, bool headless = false)
+            :m_title(title), m_width(width), m_height(height), m_headless(headless) {}
 
         std::string m_title;
         unsigned int m_width;
         unsigned int m_height;
+
+        //no visible window, the context renders offscreen so it also works without a display or GPU
+        bool m_headless;
     };
 }
\ No newline at end of file
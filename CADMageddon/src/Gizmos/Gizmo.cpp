@@ -63,7 +63,7 @@ namespace CADMageddon
         for (int i = 0; i < context->AxesCount; i++)
         {
             CameraRay axis;
-            axis.Origin = Transform.Translation;
+            axis.Origin = Transform.GetTranslation();
             axis.Direction = context->Axes[i];
             float distance = ClosestDistanceBetweenLines(cameraRay, axis);
             if (distance < minDistance)
@@ -94,17 +94,17 @@ namespace CADMageddon
 
         CameraRay cameraRay = GetCameraRay(cameraMatrix, ndcMousePosition);
         CameraRay axis;
-        axis.Origin = Transform.Translation;
+        axis.Origin = Transform.GetTranslation();
         axis.Direction = context->Axes[context->SelectedAxis];
         float minDistance = ClosestDistanceBetweenLines(cameraRay, axis);
 
         context->CurrentIntersection = cameraRay.Origin + cameraRay.Direction * cameraRay.t;
         auto delta = context->CurrentIntersection - context->PreviousIntersection;
 
-        Transform.Translation += glm::dot(delta, context->Axes[context->SelectedAxis]) * context->Axes[context->SelectedAxis];
+        Transform.SetTranslation(Transform.GetTranslation() + glm::dot(delta, context->Axes[context->SelectedAxis]) * context->Axes[context->SelectedAxis]);
 
         context->PreviousIntersection = context->CurrentIntersection;
-        context->Center = Transform.Translation;
+        context->Center = Transform.GetTranslation();
     }
 
     void Gizmo::RenderTranslation(Transform& Transform)
@@ -122,7 +122,7 @@ namespace CADMageddon
                 axis_color = glm::vec4(1.f, 0.65f, 0.f, 1.0f);
             }
 
-            Renderer::RenderLine(Transform.Translation, Transform.Translation + axis_end, axis_color);
+            Renderer::RenderLine(Transform.GetTranslation(), Transform.GetTranslation() + axis_end, axis_color);
         }
     }
 
@@ -140,7 +140,7 @@ namespace CADMageddon
         {
             Circle axis;
             axis.Radius = 1.0f;
-            axis.Center = Transform.Translation;
+            axis.Center = Transform.GetTranslation();
             axis.orientation = /*Transform.GetMatrix() */ glm::vec4(context->Axes[i], 0.0f);
             axis.orientation = glm::normalize(axis.orientation);
             float distance = ClosestDistanceLineCircle(cameraRay, axis, intersection);
@@ -175,7 +175,7 @@ namespace CADMageddon
 
         Circle axis;
         axis.Radius = 1.0f;
-        axis.Center = Transform.Translation;
+        axis.Center = Transform.GetTranslation();
         axis.orientation = /*Transform.GetMatrix() */ glm::vec4(context->Axes[context->SelectedAxis], 0.0f);
         axis.orientation = glm::normalize(axis.orientation);
 
@@ -199,11 +199,10 @@ namespace CADMageddon
         glm::vec3 rotationDelta = glm::vec3(0.0f);
         rotationDelta[context->SelectedAxis] = glm::degrees(angle);
 
-        Transform.Rotation += rotationDelta;
-        Transform.Rotation = glm::clamp(Transform.Rotation, -180.0f, 180.0f);
+        Transform.SetRotation(glm::clamp(Transform.GetRotation() + rotationDelta, -180.0f, 180.0f));
 
         context->PreviousIntersection = context->CurrentIntersection;
-        context->Center = Transform.Translation;
+        context->Center = Transform.GetTranslation();
 
     }
 
@@ -225,7 +224,7 @@ namespace CADMageddon
                 axis_color = glm::vec4(1.f, 0.65f, 0.f, 1.0f);
             }
 
-            RenderCircle(Transform.Translation, 1.0f, axis_end, axis_color);
+            RenderCircle(Transform.GetTranslation(), 1.0f, axis_end, axis_color);
         }
     }
 
@@ -278,7 +277,7 @@ namespace CADMageddon
         for (int i = 0; i < context->AxesCount; i++)
         {
             CameraRay axis;
-            axis.Origin = Transform.Translation;
+            axis.Origin = Transform.GetTranslation();
             axis.Direction = context->Axes[i];
             float distance = ClosestDistanceBetweenLines(cameraRay, axis);
             if (distance < minDistance)
@@ -308,17 +307,17 @@ namespace CADMageddon
 
         CameraRay cameraRay = GetCameraRay(cameraMatrix, ndcMousePosition);
         CameraRay axis;
-        axis.Origin = Transform.Translation;
+        axis.Origin = Transform.GetTranslation();
         axis.Direction = context->Axes[context->SelectedAxis];
         float minDistance = ClosestDistanceBetweenLines(cameraRay, axis);
 
         context->CurrentIntersection = cameraRay.Origin + cameraRay.Direction * cameraRay.t;
         auto delta = context->CurrentIntersection - context->PreviousIntersection;
 
-        Transform.Scale += glm::dot(delta, context->Axes[context->SelectedAxis]) * context->Axes[context->SelectedAxis];
+        Transform.SetScale(Transform.GetScale() + glm::dot(delta, context->Axes[context->SelectedAxis]) * context->Axes[context->SelectedAxis]);
 
         context->PreviousIntersection = context->CurrentIntersection;
-        context->Center = Transform.Translation;
+        context->Center = Transform.GetTranslation();
     }
 
     void Gizmo::RenderScale(Transform& Transform)
@@ -336,7 +335,7 @@ namespace CADMageddon
                 axis_color = glm::vec4(1.f, 0.65f, 0.f, 1.0f);
             }
 
-            Renderer::RenderLine(Transform.Translation, Transform.Translation + axis_end, axis_color);
+            Renderer::RenderLine(Transform.GetTranslation(), Transform.GetTranslation() + axis_end, axis_color);
         }
     }
 
@@ -3,10 +3,17 @@
 //void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 //void processInput(GLFWwindow* window);
 
-int main()
+int main(int argc, char** argv)
 {
     CADMageddon::Application app;
-    app.Init();
+
+    CADMageddon::BenchmarkSettings benchmarkSettings;
+    if (CADMageddon::BenchmarkSettings::ParseCommandLine(argc, argv, benchmarkSettings))
+        return app.RunBenchmark(benchmarkSettings) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if (!app.Init())
+        return EXIT_FAILURE;
+
     app.Run();
 
     return EXIT_SUCCESS;
@@ -0,0 +1,58 @@
+#pragma once
+#include <glm\glm.hpp>
+#include <limits>
+
+namespace CADMageddon
+{
+    struct BoundingBox
+    {
+        glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        bool IsEmpty() const { return Min.x > Max.x || Min.y > Max.y || Min.z > Max.z; }
+
+        void Reset()
+        {
+            Min = glm::vec3(std::numeric_limits<float>::max());
+            Max = glm::vec3(std::numeric_limits<float>::lowest());
+        }
+
+        void Expand(const glm::vec3& point)
+        {
+            Min = glm::min(Min, point);
+            Max = glm::max(Max, point);
+        }
+
+        void Expand(const BoundingBox& box)
+        {
+            if (box.IsEmpty())
+                return;
+
+            Min = glm::min(Min, box.Min);
+            Max = glm::max(Max, box.Max);
+        }
+
+        BoundingBox Transformed(const glm::mat4& transform) const
+        {
+            if (IsEmpty())
+                return *this;
+
+            glm::vec3 center = (Min + Max) * 0.5f;
+            glm::vec3 extent = (Max - Min) * 0.5f;
+
+            glm::vec3 transformedCenter = transform * glm::vec4(center, 1.0f);
+            glm::vec3 transformedExtent =
+                glm::abs(glm::vec3(transform[0])) * extent.x
+                + glm::abs(glm::vec3(transform[1])) * extent.y
+                + glm::abs(glm::vec3(transform[2])) * extent.z;
+
+            BoundingBox result;
+            result.Min = transformedCenter - transformedExtent;
+            result.Max = transformedCenter + transformedExtent;
+            return result;
+        }
+
+        bool operator==(const BoundingBox& other) const { return Min == other.Min && Max == other.Max; }
+        bool operator!=(const BoundingBox& other) const { return !(*this == other); }
+    };
+}
@@ -43,6 +43,84 @@ namespace CADMageddon
         glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
     }
 
+    /////////////////////////////////////////////////////////////////////////////
+    // RingBuffer ///////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    OpenGLRingBuffer::OpenGLRingBuffer(uint32_t regionSize, uint32_t regionCount)
+        :m_RegionSize(regionSize)
+    {
+        Allocate(regionCount);
+    }
+
+    OpenGLRingBuffer::~OpenGLRingBuffer()
+    {
+        //the base class deletes the buffer
+        Release();
+    }
+
+    bool OpenGLRingBuffer::NextRegion()
+    {
+        if (m_Fences[m_CurrentRegion])
+            glDeleteSync((GLsync)m_Fences[m_CurrentRegion]);
+
+        m_Fences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+
+        if (IsRegionFree(m_CurrentRegion))
+            return false;
+
+        //the old buffer is deleted right away, GL keeps its storage until the draws reading it are done
+        Release();
+        glDeleteBuffers(1, &m_RendererID);
+        Allocate(m_RegionCount * 2);
+        return true;
+    }
+
+    void OpenGLRingBuffer::Allocate(uint32_t regionCount)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        m_RegionCount = regionCount;
+        m_CurrentRegion = 0;
+        m_Fences.assign(regionCount, nullptr);
+
+        glGenBuffers(1, &m_RendererID);
+        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        glBufferStorage(GL_ARRAY_BUFFER, m_RegionSize * regionCount, nullptr, flags);
+        m_MappedData = (uint8_t*)glMapBufferRange(GL_ARRAY_BUFFER, 0, m_RegionSize * regionCount, flags);
+    }
+
+    void OpenGLRingBuffer::Release()
+    {
+        for (auto fence : m_Fences)
+        {
+            if (fence)
+                glDeleteSync((GLsync)fence);
+        }
+
+        m_Fences.clear();
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        m_MappedData = nullptr;
+    }
+
+    bool OpenGLRingBuffer::IsRegionFree(uint32_t region)
+    {
+        GLsync fence = (GLsync)m_Fences[region];
+        if (!fence)
+            return true;
+
+        //polled without a timeout, with enough regions the fence has long been signaled
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            return false;
+
+        glDeleteSync(fence);
+        m_Fences[region] = nullptr;
+        return true;
+    }
+
     /////////////////////////////////////////////////////////////////////////////
     // IndexBuffer //////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////
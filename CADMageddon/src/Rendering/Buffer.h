@@ -5,7 +5,7 @@ namespace CADMageddon
 {
     enum class ShaderDataType
     {
-        None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+        None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, UByte, Bool
     };
 
     static uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -22,6 +22,7 @@ namespace CADMageddon
         case ShaderDataType::Int2:     return 4 * 2;
         case ShaderDataType::Int3:     return 4 * 3;
         case ShaderDataType::Int4:     return 4 * 4;
+        case ShaderDataType::UByte:    return 1;
         case ShaderDataType::Bool:     return 1;
         }
 
@@ -57,6 +58,7 @@ namespace CADMageddon
             case ShaderDataType::Int2:    return 2;
             case ShaderDataType::Int3:    return 3;
             case ShaderDataType::Int4:    return 4;
+            case ShaderDataType::UByte:   return 1;
             case ShaderDataType::Bool:    return 1;
             }
 
@@ -75,6 +77,14 @@ namespace CADMageddon
             CalculateOffsetsAndStride();
         }
 
+        //for vertices padded past their last element, the stride is the size of the vertex struct
+        BufferLayout(const std::initializer_list<BufferElement>& elements, uint32_t stride)
+            :m_Elements(elements)
+        {
+            CalculateOffsetsAndStride();
+            m_Stride = stride;
+        }
+
         uint32_t GetStride() const { return m_Stride; }
 
         const std::vector<BufferElement>& GetElements() const { return m_Elements; }
@@ -117,11 +127,42 @@ namespace CADMageddon
         const BufferLayout& GetLayout() const { return m_Layout; }
         void SetLayout(const BufferLayout& layout) { m_Layout = layout; }
 
-    private:
+    protected:
+        OpenGLVertexBuffer() = default;
+
         uint32_t m_RendererID;
         BufferLayout m_Layout;
     };
 
+    // Persistently mapped vertex buffer split into regions, each region is written directly by the CPU
+    // and fenced after its draw so the next write to it never overwrites data the GPU still reads.
+    // When the next region is still being read the ring moves to new storage with twice the regions
+    // instead of waiting, so more flushes per frame than expected never stall the CPU.
+    class OpenGLRingBuffer : public OpenGLVertexBuffer
+    {
+    public:
+        OpenGLRingBuffer(uint32_t regionSize, uint32_t regionCount = 3);
+        ~OpenGLRingBuffer();
+
+        void* GetRegionData() const { return m_MappedData + GetRegionOffset(); }
+        uint32_t GetRegionOffset() const { return m_CurrentRegion * m_RegionSize; }
+
+        //returns true when the ring moved to new storage, vertex arrays using it have to add it again
+        bool NextRegion();
+
+    private:
+        void Allocate(uint32_t regionCount);
+        void Release();
+        bool IsRegionFree(uint32_t region);
+
+    private:
+        uint8_t* m_MappedData = nullptr;
+        uint32_t m_RegionSize;
+        uint32_t m_RegionCount;
+        uint32_t m_CurrentRegion = 0;
+        std::vector<void*> m_Fences;
+    };
+
     class OpenGLIndexBuffer
     {
     public:
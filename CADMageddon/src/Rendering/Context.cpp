@@ -11,10 +11,15 @@ namespace CADMageddon
     {
     }
 
-    void OpenGLContext::Init()
+    bool OpenGLContext::Init()
     {
         glfwMakeContextCurrent(m_windowHandle);
-        int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress); //TODO error checking
+        int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+        if (!status)
+        {
+            LOG_ERROR("Could not load OpenGL functions");
+            return false;
+        }
 
 
         LOG_INFO("OpenGL Info:");
@@ -26,6 +31,7 @@ namespace CADMageddon
         int versionMinor;
         glGetIntegerv(GL_MAJOR_VERSION, &versionMajor);
         glGetIntegerv(GL_MINOR_VERSION, &versionMinor);
+        return true;
     }
 
     void OpenGLContext::SwapBuffers()
@@ -8,7 +8,8 @@ namespace CADMageddon
     {
     public:
         OpenGLContext(GLFWwindow* windowHandle);
-        void Init();
+        //false when the OpenGL functions could not be loaded
+        bool Init();
         void SwapBuffers();
 
     private:
@@ -18,6 +18,7 @@ namespace CADMageddon
         glDeleteFramebuffers(1, &m_RendererID);
         glDeleteTextures(1, &m_ColorAttachment);
         glDeleteTextures(1, &m_DepthAttachment);
+        glDeleteTextures(1, &m_PickingAttachment);
     }
 
     void OpenGLFramebuffer::Invalidate()
@@ -27,6 +28,8 @@ namespace CADMageddon
             glDeleteFramebuffers(1, &m_RendererID);
             glDeleteTextures(1, &m_ColorAttachment);
             glDeleteTextures(1, &m_DepthAttachment);
+            glDeleteTextures(1, &m_PickingAttachment);
+            m_PickingAttachment = 0;
         }
 
         glGenFramebuffers(1, &m_RendererID);
@@ -45,6 +48,16 @@ namespace CADMageddon
         glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, m_Specification.Width, m_Specification.Height);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_DepthAttachment, 0);
 
+        if (m_Specification.HasPickingAttachment)
+        {
+            glGenTextures(1, &m_PickingAttachment);
+            glBindTexture(GL_TEXTURE_2D, m_PickingAttachment);
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, m_Specification.Width, m_Specification.Height);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_PickingAttachment, 0);
+        }
+
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
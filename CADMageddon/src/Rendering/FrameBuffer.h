@@ -9,6 +9,9 @@ namespace CADMageddon
         uint32_t Width, Height;
         uint32_t Samples = 1;
 
+        //adds an R32UI color attachment 1 the picking pass writes object ids into
+        bool HasPickingAttachment = false;
+
         bool SwapChainTarget = false;
     };
 
@@ -28,11 +31,12 @@ namespace CADMageddon
 
         uint32_t GetColorAttachmentRendererID() const { return m_ColorAttachment; }
         uint32_t GetDepthAttachmentID() const { return m_DepthAttachment; }
+        uint32_t GetPickingAttachmentID() const { return m_PickingAttachment; }
 
         const FramebufferSpecification& GetSpecification() const { return m_Specification; }
     private:
         uint32_t m_RendererID = 0;
-        uint32_t m_ColorAttachment = 0, m_DepthAttachment = 0;
+        uint32_t m_ColorAttachment = 0, m_DepthAttachment = 0, m_PickingAttachment = 0;
         FramebufferSpecification m_Specification;
 
     };
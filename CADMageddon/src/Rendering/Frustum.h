@@ -0,0 +1,49 @@
+#pragma once
+#include <glm\glm.hpp>
+#include "BoundingBox.h"
+
+namespace CADMageddon
+{
+    class Frustum
+    {
+    public:
+        Frustum() = default;
+
+        Frustum(const glm::mat4& viewProjectionMatrix)
+        {
+            glm::vec4 row0 = glm::vec4(viewProjectionMatrix[0][0], viewProjectionMatrix[1][0], viewProjectionMatrix[2][0], viewProjectionMatrix[3][0]);
+            glm::vec4 row1 = glm::vec4(viewProjectionMatrix[0][1], viewProjectionMatrix[1][1], viewProjectionMatrix[2][1], viewProjectionMatrix[3][1]);
+            glm::vec4 row2 = glm::vec4(viewProjectionMatrix[0][2], viewProjectionMatrix[1][2], viewProjectionMatrix[2][2], viewProjectionMatrix[3][2]);
+            glm::vec4 row3 = glm::vec4(viewProjectionMatrix[0][3], viewProjectionMatrix[1][3], viewProjectionMatrix[2][3], viewProjectionMatrix[3][3]);
+
+            m_Planes[0] = row3 + row0; //left
+            m_Planes[1] = row3 - row0; //right
+            m_Planes[2] = row3 + row1; //bottom
+            m_Planes[3] = row3 - row1; //top
+            m_Planes[4] = row3 + row2; //near
+            m_Planes[5] = row3 - row2; //far
+        }
+
+        bool Intersects(const BoundingBox& box) const
+        {
+            if (box.IsEmpty())
+                return false;
+
+            for (const auto& plane : m_Planes)
+            {
+                glm::vec3 positiveVertex(
+                    plane.x >= 0.0f ? box.Max.x : box.Min.x,
+                    plane.y >= 0.0f ? box.Max.y : box.Min.y,
+                    plane.z >= 0.0f ? box.Max.z : box.Min.z);
+
+                if (glm::dot(glm::vec3(plane), positiveVertex) + plane.w < 0.0f)
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        glm::vec4 m_Planes[6] = {};
+    };
+}
@@ -0,0 +1,88 @@
+#include "PickingReadback.h"
+
+#include <glad\glad.h>
+
+namespace CADMageddon
+{
+    OpenGLPickingReadback::OpenGLPickingReadback()
+    {
+        glGenBuffers(1, &m_PixelBuffer);
+    }
+
+    OpenGLPickingReadback::~OpenGLPickingReadback()
+    {
+        if (m_Fence)
+            glDeleteSync((GLsync)m_Fence);
+
+        glDeleteBuffers(1, &m_PixelBuffer);
+    }
+
+    void OpenGLPickingReadback::Request(const Ref<OpenGLFramebuffer>& framebuffer, int x, int y, int width, int height)
+    {
+        const auto& spec = framebuffer->GetSpecification();
+        int minX = std::clamp(x, 0, (int)spec.Width);
+        int minY = std::clamp(y, 0, (int)spec.Height);
+        int maxX = std::clamp(x + width, 0, (int)spec.Width);
+        int maxY = std::clamp(y + height, 0, (int)spec.Height);
+        if (minX >= maxX || minY >= maxY)
+            return;
+
+        //a newer request replaces the one still in flight
+        if (m_Fence)
+        {
+            glDeleteSync((GLsync)m_Fence);
+            m_Fence = nullptr;
+        }
+
+        m_X = minX;
+        m_Y = minY;
+        m_Width = maxX - minX;
+        m_Height = maxY - minY;
+
+        uint32_t size = m_Width * m_Height * sizeof(uint32_t);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelBuffer);
+        if (size > m_Capacity)
+        {
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+            m_Capacity = size;
+        }
+
+        framebuffer->Bind();
+        glReadBuffer(GL_COLOR_ATTACHMENT1);
+        glReadPixels(m_X, m_Y, m_Width, m_Height, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        framebuffer->UnBind();
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    bool OpenGLPickingReadback::IsReady() const
+    {
+        if (!m_Fence)
+            return false;
+
+        GLenum result = glClientWaitSync((GLsync)m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    std::vector<uint32_t> OpenGLPickingReadback::Read()
+    {
+        std::vector<uint32_t> ids(m_Width * m_Height);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelBuffer);
+        auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, ids.size() * sizeof(uint32_t), GL_MAP_READ_BIT);
+        if (data)
+        {
+            std::memcpy(ids.data(), data, ids.size() * sizeof(uint32_t));
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glDeleteSync((GLsync)m_Fence);
+        m_Fence = nullptr;
+
+        return ids;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "cadpch.h"
+#include "Core\Base.h"
+#include "FrameBuffer.h"
+
+namespace CADMageddon
+{
+    //asynchronous readback of the picking attachment through a pixel buffer,
+    //the copy is queued on the GPU and read only once its fence has signaled
+    class OpenGLPickingReadback
+    {
+    public:
+        OpenGLPickingReadback();
+        ~OpenGLPickingReadback();
+
+        //region is in framebuffer pixels with origin in the bottom left corner
+        void Request(const Ref<OpenGLFramebuffer>& framebuffer, int x, int y, int width, int height);
+
+        bool GetIsPending() const { return m_Fence != nullptr; }
+        bool IsReady() const;
+
+        //ids of the requested region row by row starting from the bottom one
+        std::vector<uint32_t> Read();
+
+        int GetX() const { return m_X; }
+        int GetY() const { return m_Y; }
+        int GetWidth() const { return m_Width; }
+        int GetHeight() const { return m_Height; }
+
+    private:
+        uint32_t m_PixelBuffer = 0;
+        uint32_t m_Capacity = 0;
+        void* m_Fence = nullptr;
+
+        int m_X = 0;
+        int m_Y = 0;
+        int m_Width = 0;
+        int m_Height = 0;
+    };
+}
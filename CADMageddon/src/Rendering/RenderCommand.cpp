@@ -0,0 +1,87 @@
+#include "RenderCommand.h"
+
+namespace CADMageddon
+{
+    void RenderCommandList::Clear()
+    {
+        //clear keeps the capacity so a steady frame records without allocating
+        m_Commands.clear();
+        m_SortKeys.clear();
+        m_IsSorted = true;
+
+        m_Vertices.clear();
+        m_Indices.clear();
+
+        m_Points.clear();
+        m_Lines.clear();
+
+        //groups of colors no longer drawn are dropped, the others keep their capacity
+        m_BezierSegments.erase(std::remove_if(m_BezierSegments.begin(), m_BezierSegments.end(),
+            [](const BezierSegmentBatch& batch) { return batch.Vertices.empty(); }), m_BezierSegments.end());
+        for (auto& batch : m_BezierSegments)
+            batch.Vertices.clear();
+    }
+
+    RenderCommand& RenderCommandList::AddCommand(RenderCommandType type, RenderLayer layer, uint32_t stateId)
+    {
+        uint64_t index = m_Commands.size();
+        uint64_t sortKey =
+            (uint64_t)layer << 56
+            | (uint64_t)type << 48
+            | (uint64_t)(stateId & 0xFFFF) << 32
+            | index;
+
+        m_SortKeys.push_back(sortKey);
+        m_IsSorted = false;
+
+        m_Commands.emplace_back();
+        auto& command = m_Commands.back();
+        command.Type = type;
+        command.Layer = layer;
+        return command;
+    }
+
+    uint32_t RenderCommandList::AddVertices(const glm::vec3* vertices, uint32_t count)
+    {
+        uint32_t first = m_Vertices.size();
+        m_Vertices.insert(m_Vertices.end(), vertices, vertices + count);
+        return first;
+    }
+
+    uint32_t RenderCommandList::AddIndices(const uint32_t* indices, uint32_t count)
+    {
+        uint32_t first = m_Indices.size();
+        m_Indices.insert(m_Indices.end(), indices, indices + count);
+        return first;
+    }
+
+    void RenderCommandList::AddLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color)
+    {
+        m_Lines.push_back({ start, color });
+        m_Lines.push_back({ end, color });
+    }
+
+    void RenderCommandList::AddBezierSegment(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, const glm::vec4& color)
+    {
+        //a scene uses a handful of curve colors, a linear search finds the group
+        auto it = std::find_if(m_BezierSegments.begin(), m_BezierSegments.end(), [&color](const BezierSegmentBatch& batch) { return batch.Color == color; });
+        if (it == m_BezierSegments.end())
+        {
+            m_BezierSegments.push_back({ color });
+            it = m_BezierSegments.end() - 1;
+        }
+
+        it->Vertices.insert(it->Vertices.end(), { { p0 }, { p1 }, { p2 }, { p3 } });
+    }
+
+    const std::vector<uint64_t>& RenderCommandList::GetSortedKeys()
+    {
+        if (!m_IsSorted)
+        {
+            std::sort(m_SortKeys.begin(), m_SortKeys.end());
+            m_IsSorted = true;
+        }
+
+        return m_SortKeys;
+    }
+}
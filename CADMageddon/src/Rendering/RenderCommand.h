@@ -0,0 +1,102 @@
+#pragma once
+#include "cadpch.h"
+#include "Core\Base.h"
+#include "VertexArray.h"
+#include "RenderData.h"
+#include <glm/glm.hpp>
+
+namespace CADMageddon
+{
+    //layers keep the drawing order that blending and depth rely on, commands are sorted by state only inside a layer
+    enum class RenderLayer : uint8_t
+    {
+        Opaque = 0,
+        Grid = 1,
+        Overlay = 2
+    };
+
+    enum class RenderCommandType : uint8_t
+    {
+        Torus,
+        TrimmedTorus,
+        BezierPatch,
+        BSplinePatch,
+        GregoryPatches,
+        Grid,
+        LineStrip,
+        ScreenQuad,
+        ScreenQuadBorder
+    };
+
+    struct RenderCommand
+    {
+        RenderCommandType Type = RenderCommandType::Torus;
+        RenderLayer Layer = RenderLayer::Opaque;
+        glm::vec4 Color = glm::vec4(1.0f);
+
+        //owned by the scene, which outlives the frame the command is recorded in
+        const OpenGLVertexArray* VertexArray = nullptr;
+        glm::mat4 Transform = glm::mat4(1.0f);
+
+        unsigned int TextureId = 0;
+        bool IsTrimmed = false;
+        bool ReverseTrimming = false;
+
+        //ranges in the vertex and index storage of the command list
+        uint32_t FirstVertex = 0;
+        uint32_t VertexCount = 0;
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+
+        int PatchCountX = 0;
+        int PatchCountY = 0;
+        int USubdivisionCount = 0;
+        int VSubdivisionCount = 0;
+    };
+
+    //the curve shader takes its color from a uniform, segments are grouped by color and drawn once per group
+    struct BezierSegmentBatch
+    {
+        glm::vec4 Color;
+        std::vector<Vertex> Vertices;
+    };
+
+    // Draws recorded during a frame. Geometry that does not live in GPU buffers is copied into the list
+    // so it can be submitted after sorting and submitted again for the second stereo eye.
+    class RenderCommandList
+    {
+    public:
+        void Clear();
+
+        RenderCommand& AddCommand(RenderCommandType type, RenderLayer layer, uint32_t stateId = 0);
+        uint32_t AddVertices(const glm::vec3* vertices, uint32_t count);
+        uint32_t AddIndices(const uint32_t* indices, uint32_t count);
+
+        void AddPoint(const glm::vec3& position, uint8_t state) { m_Points.push_back({ position, state }); }
+        void AddLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color);
+        void AddBezierSegment(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, const glm::vec4& color);
+
+        //sort keys hold the command index in their low bits, the list is sorted once however many times it is submitted
+        const std::vector<uint64_t>& GetSortedKeys();
+        const RenderCommand& GetCommand(uint64_t sortKey) const { return m_Commands[sortKey & 0xFFFFFFFF]; }
+
+        const std::vector<glm::vec3>& GetVertices() const { return m_Vertices; }
+        const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+
+        const std::vector<PointInstance>& GetPoints() const { return m_Points; }
+        const std::vector<VertexC>& GetLines() const { return m_Lines; }
+        const std::vector<BezierSegmentBatch>& GetBezierSegments() const { return m_BezierSegments; }
+
+    private:
+        std::vector<RenderCommand> m_Commands;
+        std::vector<uint64_t> m_SortKeys;
+        bool m_IsSorted = true;
+
+        std::vector<glm::vec3> m_Vertices;
+        std::vector<uint32_t> m_Indices;
+
+        std::vector<PointInstance> m_Points;
+        std::vector<VertexC> m_Lines;
+        std::vector<BezierSegmentBatch> m_BezierSegments;
+    };
+}
@@ -17,32 +17,64 @@ namespace CADMageddon
         glm::vec4 Color;
     };
 
+    struct VertexId
+    {
+        glm::vec3 Position;
+        uint32_t Id;
+    };
+
+    //one instanced point sprite, State is the packed PointState, see Renderer.h
+    //the state is read as a single unsigned byte attribute, the padding keeps every position 4-byte aligned
+    struct PointInstance
+    {
+        glm::vec3 Position;
+        uint8_t State;
+        uint8_t Padding[3] = {};
+    };
+    static_assert(sizeof(PointInstance) == 16, "the point sprite layout expects 16 byte instances");
+
     struct VertexT
     {
         glm::vec3 Position;
         glm::vec2 TextureCoordinates;
     };
 
-    struct RenderTorusData
+    struct RenderGridData
     {
-        static const int MaxVertices = 20000;
-        static const int MaxIndices = MaxVertices * 4;
+        static constexpr float CellSize = 1.0f;
+        static constexpr float MinPixelsBetweenCells = 4.0f;
+
+        //the grid is generated from gl_VertexID, the vertex array has no buffers
+        Ref<OpenGLVertexArray> GridVertexArray;
+        Ref<OpenGLShader> GridShader;
+    };
 
-        Ref<OpenGLVertexArray> TorusVertexArray;
-        Ref<OpenGLVertexBuffer> TorusVertexBuffer;
-        Ref<OpenGLIndexBuffer> TorusIndexBuffer;
+    struct RenderTorusData
+    {
         Ref<OpenGLShader> TorusShader;
     };
 
+    struct RenderLineStripData
+    {
+        //strips live in vertex arrays owned by their objects, only the shader is shared
+        Ref<OpenGLShader> Shader;
+    };
+
     struct RenderPointData
     {
-        static const int MaxPoints = 50000;
+        static const int MaxPoints = 100000;
+        static const int BufferedBatches = 3;
+        static const int TypeCount = 3;
         Ref <OpenGLVertexArray> PointsVertexArray;
-        Ref<OpenGLVertexBuffer> PointsVertexBuffer;
+        Ref<OpenGLRingBuffer> PointsVertexBuffer;
         Ref<OpenGLShader> Shader;
 
-        VertexC* PointVertexBufferBase = nullptr;
-        VertexC* PointVertexBufferPtr = nullptr;
+        PointInstance* PointVertexBufferBase = nullptr;
+        PointInstance* PointVertexBufferPtr = nullptr;
+
+        //looked up in the shader by point type, colors hold the unselected and the selected color of each type
+        glm::vec4 Colors[TypeCount * 2];
+        float SizeScales[TypeCount] = { 1.0f, 1.0f, 1.0f };
 
         int Count = 0;
     };
@@ -50,8 +82,9 @@ namespace CADMageddon
     struct RenderLineData
     {
         static const int MaxLines = 50000;
+        static const int BufferedBatches = 3;
         Ref <OpenGLVertexArray> LinesVertexArray;
-        Ref<OpenGLVertexBuffer> LinesVertexBuffer;
+        Ref<OpenGLRingBuffer> LinesVertexBuffer;
         Ref<OpenGLShader> Shader;
 
         VertexC* LinesVertexBufferBase = nullptr;
@@ -62,12 +95,19 @@ namespace CADMageddon
 
     struct RenderBezierCurveData
     {
-        static const int MaxPoints = 4;
+        static const int MaxSegments = 20000;
+        static const int MaxPoints = MaxSegments * 4;
+        static const int BufferedBatches = 3;
 
         Ref<OpenGLVertexArray> BezierVertexArray;
-        Ref<OpenGLVertexBuffer> BezierVertexBuffer;
-        Ref<OpenGLShader> QuadraticBezierShader;
+        Ref<OpenGLRingBuffer> BezierVertexBuffer;
         Ref<OpenGLShader> CubicBezierShader;
+        Vertex* BezierVertexBufferBase = nullptr;
+        Vertex* BezierVertexBufferPtr = nullptr;
+
+        //every vertex in the buffer is drawn with this color, set before streaming each color group
+        glm::vec4 Color = glm::vec4(1.0f);
+        int Count = 0;
     };
 
     struct RenderBezierPatchData
@@ -103,12 +143,39 @@ namespace CADMageddon
 
     struct RenderGregoryPatchData
     {
-        static const int MaxPoints = 200;
+        static const int PointsPerPatch = 20;
+        static const int MaxPatches = 300;
+        static const int MaxPoints = PointsPerPatch * MaxPatches;
+
+        //every isoline is split into this many instances, each limited to GL_MAX_TESS_GEN_LEVEL segments
+        static const int ChunkCount = 4;
+
         Ref<OpenGLVertexArray> GregoryVertexArray;
         Ref<OpenGLVertexBuffer> GregoryVertexBuffer;
         Ref<OpenGLShader> GregoryShader;
     };
 
+    struct RenderPickingData
+    {
+        static const int MaxPoints = 50000;
+        static const int MaxLines = 100000;
+        static const int BufferedBatches = 3;
+
+        Ref<OpenGLVertexArray> PointsVertexArray;
+        Ref<OpenGLRingBuffer> PointsVertexBuffer;
+        VertexId* PointVertexBufferBase = nullptr;
+        VertexId* PointVertexBufferPtr = nullptr;
+        int PointCount = 0;
+
+        Ref<OpenGLVertexArray> LinesVertexArray;
+        Ref<OpenGLRingBuffer> LinesVertexBuffer;
+        VertexId* LinesVertexBufferBase = nullptr;
+        VertexId* LinesVertexBufferPtr = nullptr;
+        int LineCount = 0;
+
+        Ref<OpenGLShader> Shader;
+    };
+
     struct RenderTextureQuadData
     {
         static const int PointCount = 6;
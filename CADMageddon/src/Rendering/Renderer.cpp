@@ -2,7 +2,9 @@
 #include "Renderer.h"
 
 #include "RenderData.h"
+#include "RenderCommand.h"
 #include <glad\glad.h>
+#include <chrono>
 
 namespace CADMageddon
 {
@@ -31,9 +33,11 @@ namespace CADMageddon
     Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
     Scope<ShaderLibrary> Renderer::s_ShaderLibrary = CreateScope<ShaderLibrary>();
 
+    static RenderGridData s_RenderGridData;
     static RenderTorusData s_RenderTorusData;
     static RenderPointData s_RenderPointData;
     static RenderLineData s_RenderLineData;
+    static RenderLineStripData s_RenderLineStripData;
     static RenderBezierCurveData s_RenderBezierCurveData;
     static RenderBezierPatchData s_RenderBezierPatchData;
     static RenderBSplinePatchData s_RenderBSplinePatchData;
@@ -41,6 +45,15 @@ namespace CADMageddon
     static RenderGregoryPatchData s_RenderGregoryPatch;
 
     static RenderTextureQuadData s_RenderTextureQuadData;
+    static RenderPickingData s_RenderPickingData;
+
+    static RenderCommandList s_CommandList;
+
+    //state set by the commands of the submit in progress, only changes are sent to OpenGL
+    static const OpenGLShader* s_BoundShader = nullptr;
+    static unsigned int s_PolygonMode = GL_FILL;
+
+    RenderStats Renderer::s_Stats;
 
     void Renderer::Init()
     {
@@ -57,18 +70,36 @@ namespace CADMageddon
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        s_ShaderLibrary->Load("FlatColorShader", "assets/shaders/FlatColorShader.glsl");
-        s_ShaderLibrary->Load("ColorShader", "assets/shaders/ColorShader.glsl");
-        s_ShaderLibrary->Load("CubicBezierCurveShader", "assets/shaders/CubicBezierCurveShader.glsl");
-        s_ShaderLibrary->Load("QuadraticBezierCurveShader", "assets/shaders/QuadraticBezierCurveShader.glsl");
-        s_ShaderLibrary->Load("BezierPatchShader", "assets/shaders/BezierPatchShader.glsl");
-        s_ShaderLibrary->Load("BSplinePatchShader", "assets/shaders/BSplinePatchShader.glsl");
-        s_ShaderLibrary->Load("SelectionBoxShader", "assets/shaders/SelectionBoxShader.glsl");
-        s_ShaderLibrary->Load("GregoryPatchShader", "assets/shaders/GregoryPatchShader.glsl");
-        s_ShaderLibrary->Load("TorusShader", "assets/shaders/TorusShader.glsl");
-        s_ShaderLibrary->Load("TextureQuadShader", "assets/shaders/TextureShader.glsl");
+        auto shaderLoadStart = std::chrono::high_resolution_clock::now();
+
+        s_ShaderLibrary->SetBinaryCacheDirectory("cache/shaders");
+        std::vector<Ref<OpenGLShader>> shaders = {
+            s_ShaderLibrary->Load("FlatColorShader", "assets/shaders/FlatColorShader.glsl"),
+            s_ShaderLibrary->Load("ColorShader", "assets/shaders/ColorShader.glsl"),
+            s_ShaderLibrary->Load("CubicBezierCurveShader", "assets/shaders/CubicBezierCurveShader.glsl"),
+            s_ShaderLibrary->Load("BezierPatchShader", "assets/shaders/BezierPatchShader.glsl"),
+            s_ShaderLibrary->Load("BSplinePatchShader", "assets/shaders/BSplinePatchShader.glsl"),
+            s_ShaderLibrary->Load("SelectionBoxShader", "assets/shaders/SelectionBoxShader.glsl"),
+            s_ShaderLibrary->Load("GregoryPatchShader", "assets/shaders/GregoryPatchShader.glsl"),
+            s_ShaderLibrary->Load("TorusShader", "assets/shaders/TorusShader.glsl"),
+            s_ShaderLibrary->Load("TextureQuadShader", "assets/shaders/TextureShader.glsl"),
+            s_ShaderLibrary->Load("TrimTextureShader", "assets/shaders/TrimTextureShader.glsl"),
+            s_ShaderLibrary->Load("PickingShader", "assets/shaders/PickingShader.glsl"),
+            s_ShaderLibrary->Load("GridShader", "assets/shaders/GridShader.glsl"),
+            s_ShaderLibrary->Load("PointSpriteShader", "assets/shaders/PointSpriteShader.glsl")
+        };
+
+        auto shaderLoadEnd = std::chrono::high_resolution_clock::now();
+        int cachedCount = std::count_if(shaders.begin(), shaders.end(), [](const Ref<OpenGLShader>& shader) { return shader->GetIsLoadedFromCache(); });
+        LOG_INFO("Loaded {0} shaders in {1} ms ({2} start, {3} from program binary cache)",
+            shaders.size(),
+            std::chrono::duration<float, std::milli>(shaderLoadEnd - shaderLoadStart).count(),
+            cachedCount == shaders.size() ? "warm" : "cold",
+            cachedCount);
 
+        InitGridRenderData();
         InitTorusRenderData();
+        InitLineStripRenderData();
         InitPointRenderData();
         InitLineRenderData();
         InitBezierCurveRenderData();
@@ -77,40 +108,74 @@ namespace CADMageddon
         InitGregoryPatchRenderData();
         InitSelectionBoxRenderData();
         InitTextureQuadRenderData();
+        InitPickingRenderData();
+    }
+
+    void Renderer::InitGridRenderData()
+    {
+        s_RenderGridData.GridVertexArray = CreateRef<OpenGLVertexArray>();
+        s_RenderGridData.GridShader = s_ShaderLibrary->Get("GridShader");
     }
 
     void Renderer::InitTorusRenderData()
     {
-        s_RenderTorusData.TorusVertexArray = CreateRef<OpenGLVertexArray>();
-        s_RenderTorusData.TorusVertexBuffer = CreateRef<OpenGLVertexBuffer>(s_RenderTorusData.MaxVertices * sizeof(VertexT));
-        s_RenderTorusData.TorusIndexBuffer = CreateRef<OpenGLIndexBuffer>(s_RenderTorusData.MaxIndices);
+        //torus meshes live in vertex arrays owned by each torus, only the shader is shared
+        s_RenderTorusData.TorusShader = s_ShaderLibrary->Get("TorusShader");
+    }
+
+    void Renderer::InitLineStripRenderData()
+    {
+        s_RenderLineStripData.Shader = s_ShaderLibrary->Get("FlatColorShader");
+    }
 
-        s_RenderTorusData.TorusVertexBuffer->SetLayout({
+    void Renderer::InitPickingRenderData()
+    {
+        s_RenderPickingData.PointsVertexArray = CreateRef<OpenGLVertexArray>();
+        s_RenderPickingData.PointsVertexBuffer = CreateRef<OpenGLRingBuffer>(s_RenderPickingData.MaxPoints * sizeof(VertexId), s_RenderPickingData.BufferedBatches);
+        s_RenderPickingData.PointsVertexBuffer->SetLayout({
             { ShaderDataType::Float3, "a_Position" },
-            { ShaderDataType::Float2, "a_TextureCoordinates" }
+            { ShaderDataType::Int, "a_Id" }
             });
+        s_RenderPickingData.PointsVertexArray->AddVertexBuffer(s_RenderPickingData.PointsVertexBuffer);
+        s_RenderPickingData.PointVertexBufferBase = (VertexId*)s_RenderPickingData.PointsVertexBuffer->GetRegionData();
+        s_RenderPickingData.PointVertexBufferPtr = s_RenderPickingData.PointVertexBufferBase;
 
-        s_RenderTorusData.TorusVertexArray->AddVertexBuffer(s_RenderTorusData.TorusVertexBuffer);
-        s_RenderTorusData.TorusVertexArray->SetIndexBuffer(s_RenderTorusData.TorusIndexBuffer);
-        s_RenderTorusData.TorusShader = s_ShaderLibrary->Get("TorusShader");
+        s_RenderPickingData.LinesVertexArray = CreateRef<OpenGLVertexArray>();
+        s_RenderPickingData.LinesVertexBuffer = CreateRef<OpenGLRingBuffer>(s_RenderPickingData.MaxLines * sizeof(VertexId), s_RenderPickingData.BufferedBatches);
+        s_RenderPickingData.LinesVertexBuffer->SetLayout({
+            { ShaderDataType::Float3, "a_Position" },
+            { ShaderDataType::Int, "a_Id" }
+            });
+        s_RenderPickingData.LinesVertexArray->AddVertexBuffer(s_RenderPickingData.LinesVertexBuffer);
+        s_RenderPickingData.LinesVertexBufferBase = (VertexId*)s_RenderPickingData.LinesVertexBuffer->GetRegionData();
+        s_RenderPickingData.LinesVertexBufferPtr = s_RenderPickingData.LinesVertexBufferBase;
+
+        s_RenderPickingData.Shader = s_ShaderLibrary->Get("PickingShader");
     }
 
     void Renderer::InitPointRenderData()
     {
         s_RenderPointData.PointsVertexArray = CreateRef<OpenGLVertexArray>();
 
-        s_RenderPointData.PointsVertexBuffer = CreateRef<OpenGLVertexBuffer>(s_RenderPointData.MaxPoints * sizeof(VertexC));
-        s_RenderPointData.PointsVertexBuffer->SetLayout({
+        //one instance per point, the sprite corners come from gl_VertexID
+        s_RenderPointData.PointsVertexBuffer = CreateRef<OpenGLRingBuffer>(s_RenderPointData.MaxPoints * sizeof(PointInstance), s_RenderPointData.BufferedBatches);
+        s_RenderPointData.PointsVertexBuffer->SetLayout(BufferLayout({
             { ShaderDataType::Float3, "a_Position" },
-            { ShaderDataType::Float4, "a_Color" }
-            });
+            { ShaderDataType::UByte, "a_State" }
+            }, sizeof(PointInstance)));
 
-        s_RenderPointData.PointsVertexArray->AddVertexBuffer(s_RenderPointData.PointsVertexBuffer);
+        s_RenderPointData.PointsVertexArray->AddVertexBuffer(s_RenderPointData.PointsVertexBuffer, 1);
 
-        s_RenderPointData.Shader = s_ShaderLibrary->Get("ColorShader");
+        s_RenderPointData.Shader = s_ShaderLibrary->Get("PointSpriteShader");
 
-        s_RenderPointData.PointVertexBufferBase = new VertexC[s_RenderPointData.MaxPoints];
+        s_RenderPointData.PointVertexBufferBase = (PointInstance*)s_RenderPointData.PointsVertexBuffer->GetRegionData();
+        s_RenderPointData.PointVertexBufferPtr = s_RenderPointData.PointVertexBufferBase;
 
+        SetPointStyle(PointType::Control, DEFAULT_COLOR, SELECTED_COLOR);
+        SetPointStyle(PointType::Virtual, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), SELECTED_COLOR);
+        SetPointStyle(PointType::Marker, glm::vec4(1.0f, 0.0f, 1.0f, 1.0f), glm::vec4(1.0f, 0.0f, 1.0f, 1.0f));
+
+        //still used by the picking pass, which draws plain GL_POINTS
         glPointSize(PointSize);
     }
 
@@ -118,7 +183,7 @@ namespace CADMageddon
     {
         s_RenderLineData.LinesVertexArray = CreateRef<OpenGLVertexArray>();
 
-        s_RenderLineData.LinesVertexBuffer = CreateRef<OpenGLVertexBuffer>(s_RenderLineData.MaxLines * sizeof(VertexC));
+        s_RenderLineData.LinesVertexBuffer = CreateRef<OpenGLRingBuffer>(s_RenderLineData.MaxLines * sizeof(VertexC), s_RenderLineData.BufferedBatches);
         s_RenderLineData.LinesVertexBuffer->SetLayout({
             { ShaderDataType::Float3, "a_Position" },
             { ShaderDataType::Float4, "a_Color" }
@@ -128,7 +193,8 @@ namespace CADMageddon
 
         s_RenderLineData.Shader = s_ShaderLibrary->Get("ColorShader");
 
-        s_RenderLineData.LinesVertexBufferBase = new VertexC[s_RenderLineData.MaxLines];
+        s_RenderLineData.LinesVertexBufferBase = (VertexC*)s_RenderLineData.LinesVertexBuffer->GetRegionData();
+        s_RenderLineData.LinesVertexBufferPtr = s_RenderLineData.LinesVertexBufferBase;
 
         //glLineWidth(10.0f);
     }
@@ -137,14 +203,15 @@ namespace CADMageddon
     {
         s_RenderBezierCurveData.BezierVertexArray = CreateRef<OpenGLVertexArray>();
 
-        s_RenderBezierCurveData.BezierVertexBuffer = CreateRef<OpenGLVertexBuffer>(s_RenderBezierCurveData.MaxPoints * sizeof(Vertex));
+        s_RenderBezierCurveData.BezierVertexBuffer = CreateRef<OpenGLRingBuffer>(s_RenderBezierCurveData.MaxPoints * sizeof(Vertex), s_RenderBezierCurveData.BufferedBatches);
         s_RenderBezierCurveData.BezierVertexBuffer->SetLayout({
             { ShaderDataType::Float3, "a_Position" },
             });
 
         s_RenderBezierCurveData.BezierVertexArray->AddVertexBuffer(s_RenderBezierCurveData.BezierVertexBuffer);
+        s_RenderBezierCurveData.BezierVertexBufferBase = (Vertex*)s_RenderBezierCurveData.BezierVertexBuffer->GetRegionData();
+        s_RenderBezierCurveData.BezierVertexBufferPtr = s_RenderBezierCurveData.BezierVertexBufferBase;
 
-        s_RenderBezierCurveData.QuadraticBezierShader = s_ShaderLibrary->Get("QuadraticBezierCurveShader");
         s_RenderBezierCurveData.CubicBezierShader = s_ShaderLibrary->Get("CubicBezierCurveShader");
     }
 
@@ -209,9 +276,9 @@ namespace CADMageddon
     {
         s_RenderGregoryPatch.GregoryVertexArray = CreateRef<OpenGLVertexArray>();
 
-        s_RenderGregoryPatch.GregoryVertexBuffer = CreateRef<OpenGLVertexBuffer>(s_RenderGregoryPatch.MaxPoints * sizeof(float));
+        s_RenderGregoryPatch.GregoryVertexBuffer = CreateRef<OpenGLVertexBuffer>(s_RenderGregoryPatch.MaxPoints * sizeof(glm::vec3));
         s_RenderGregoryPatch.GregoryVertexBuffer->SetLayout({
-            { ShaderDataType::Float, "a_Position" },
+            { ShaderDataType::Float3, "a_Position" },
             });
 
         s_RenderGregoryPatch.GregoryVertexArray->AddVertexBuffer(s_RenderGregoryPatch.GregoryVertexBuffer);
@@ -266,199 +333,413 @@ namespace CADMageddon
     void Renderer::BeginScene(const glm::mat4& viewProjectionMatrix)
     {
         s_SceneData->ViewProjectionMatrix = viewProjectionMatrix;
+        s_SceneData->ViewFrustum = Frustum(viewProjectionMatrix);
+        s_SceneData->IsStereo = false;
 
-        s_RenderPointData.PointVertexBufferPtr = s_RenderPointData.PointVertexBufferBase;
-        s_RenderPointData.Count = 0;
-
-        s_RenderLineData.LinesVertexBufferPtr = s_RenderLineData.LinesVertexBufferBase;
-        s_RenderLineData.Count = 0;
+        s_CommandList.Clear();
     }
 
-    void Renderer::EndScene()
+    void Renderer::BeginStereoScene(const glm::mat4& leftViewProjectionMatrix, const glm::mat4& rightViewProjectionMatrix)
     {
-        uint32_t pointDataSize = (uint32_t)((uint8_t*)s_RenderPointData.PointVertexBufferPtr - (uint8_t*)s_RenderPointData.PointVertexBufferBase);
-        s_RenderPointData.PointsVertexBuffer->SetData(s_RenderPointData.PointVertexBufferBase, pointDataSize);
-
-        FlushPoints();
+        s_SceneData->ViewProjectionMatrix = leftViewProjectionMatrix;
+        s_SceneData->ViewFrustum = Frustum(leftViewProjectionMatrix);
+        s_SceneData->SecondViewFrustum = Frustum(rightViewProjectionMatrix);
+        s_SceneData->IsStereo = true;
 
-        uint32_t lineDataSize = (uint32_t)((uint8_t*)s_RenderLineData.LinesVertexBufferPtr - (uint8_t*)s_RenderLineData.LinesVertexBufferBase);
-        s_RenderLineData.LinesVertexBuffer->SetData(s_RenderLineData.LinesVertexBufferBase, lineDataSize);
+        s_CommandList.Clear();
+    }
 
-        FlushLines();
+    void Renderer::EndScene()
+    {
+        SubmitCommands(s_SceneData->ViewProjectionMatrix, nullptr);
     }
 
-    void Renderer::RenderTorus(
-        const std::vector<glm::vec3>& vertices,
-        const std::vector<glm::vec2>& textureCoordinates,
-        const::std::vector<uint32_t>& indices,
-        const glm::mat4& transform,
-        const glm::vec4& color)
+    void Renderer::SubmitScene(const glm::mat4& viewProjectionMatrix)
     {
+        SubmitCommands(viewProjectionMatrix, nullptr);
+    }
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    void Renderer::SubmitScene(const glm::mat4& viewProjectionMatrix, const glm::vec4& colorOverride)
+    {
+        SubmitCommands(viewProjectionMatrix, &colorOverride);
+    }
 
-        s_RenderTorusData.TorusShader->Bind();
-        s_RenderTorusData.TorusShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-        s_RenderTorusData.TorusShader->SetMat4("u_ModelMatrix", transform);
-        s_RenderTorusData.TorusShader->SetFloat4("u_Color", color);
-        s_RenderTorusData.TorusShader->SetBool("isTrimmed", false);
+    void Renderer::SubmitCommands(const glm::mat4& viewProjectionMatrix, const glm::vec4* colorOverride)
+    {
+        s_SceneData->ViewProjectionMatrix = viewProjectionMatrix;
+        s_BoundShader = nullptr;
+        s_PolygonMode = GL_FILL;
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-        std::vector<float> verticesData(vertices.size() * 5);
-        for (int i = 0; i < vertices.size(); i++)
+        //batched curves, points and lines go after the scene and the grid, as they did when flushed in EndScene
+        bool batchesSubmitted = false;
+        for (auto sortKey : s_CommandList.GetSortedKeys())
         {
-            verticesData[5 * i] = vertices[i].x;
-            verticesData[5 * i + 1] = vertices[i].y;
-            verticesData[5 * i + 2] = vertices[i].z;
-            verticesData[5 * i + 3] = textureCoordinates[i].x;
-            verticesData[5 * i + 4] = textureCoordinates[i].y;
-        }
+            const auto& command = s_CommandList.GetCommand(sortKey);
+            if (!batchesSubmitted && command.Layer == RenderLayer::Overlay)
+            {
+                SubmitBatches(colorOverride);
+                batchesSubmitted = true;
+            }
 
-        s_RenderTorusData.TorusVertexArray->Bind();
-        s_RenderTorusData.TorusVertexBuffer->SetData(verticesData.data(), vertices.size() * sizeof(VertexT));
-        s_RenderTorusData.TorusIndexBuffer->SetIndices(indices.data(), indices.size());
+            ExecuteCommand(command, colorOverride ? *colorOverride : command.Color);
+        }
 
-        glDrawElements(GL_LINES, s_RenderTorusData.TorusVertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+        if (!batchesSubmitted)
+            SubmitBatches(colorOverride);
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        SetPolygonMode(GL_FILL);
     }
 
-    void Renderer::RenderTrimmedTorus(
-        const std::vector<glm::vec3>& vertices,
-        const std::vector<glm::vec2>& textureCoordinates,
-        const bool reverseTrimming,
-        const unsigned int textureId,
-        const std::vector<uint32_t>& indices,
-        const glm::mat4& transform,
-        const glm::vec4& color)
+    //copies recorded vertices into the mapped ring buffer region, flushing whenever it fills up
+    template<typename TVertex>
+    static void StreamVertices(
+        const std::vector<TVertex>& vertices,
+        const glm::vec4* colorOverride,
+        int verticesPerPrimitive,
+        int maxVertices,
+        TVertex*& bufferPtr,
+        int& count,
+        void (*flushAndReset)())
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        size_t written = 0;
+        while (written < vertices.size())
+        {
+            int capacity = (maxVertices - count) / verticesPerPrimitive * verticesPerPrimitive;
+            if (capacity == 0)
+            {
+                flushAndReset();
+                continue;
+            }
 
-        s_RenderTorusData.TorusShader->Bind();
-        s_RenderTorusData.TorusShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-        s_RenderTorusData.TorusShader->SetMat4("u_ModelMatrix", transform);
-        s_RenderTorusData.TorusShader->SetFloat4("u_Color", color);
-        s_RenderTorusData.TorusShader->SetBool("isTrimmed", true);
-        s_RenderTorusData.TorusShader->SetBool("reverseTrimming", reverseTrimming);
+            size_t chunk = std::min(vertices.size() - written, (size_t)capacity);
+            std::copy_n(vertices.data() + written, chunk, bufferPtr);
 
+            //point colors are shader uniforms, SubmitBatches overrides those instead
+            if constexpr (std::is_same_v<TVertex, VertexC>)
+            {
+                if (colorOverride)
+                {
+                    for (size_t i = 0; i < chunk; i++)
+                        bufferPtr[i].Color = *colorOverride;
+                }
+            }
 
-        s_RenderTorusData.TorusVertexArray->Bind();
-        std::vector<float> verticesData(vertices.size() * 5);
-        for (int i = 0; i < vertices.size(); i++)
-        {
-            verticesData[5 * i] = vertices[i].x;
-            verticesData[5 * i + 1] = vertices[i].y;
-            verticesData[5 * i + 2] = vertices[i].z;
-            verticesData[5 * i + 3] = textureCoordinates[i].x;
-            verticesData[5 * i + 4] = textureCoordinates[i].y;
+            bufferPtr += chunk;
+            count += chunk;
+            written += chunk;
         }
 
-        s_RenderTorusData.TorusVertexBuffer->SetData(verticesData.data(), vertices.size() * sizeof(VertexT));
-        s_RenderTorusData.TorusIndexBuffer->SetIndices(indices.data(), indices.size());
+        flushAndReset();
+    }
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        s_RenderTorusData.TorusShader->SetBool("trimmingSampler", 0);
+    void Renderer::SubmitBatches(const glm::vec4* colorOverride)
+    {
+        for (const auto& batch : s_CommandList.GetBezierSegments())
+        {
+            s_RenderBezierCurveData.Color = colorOverride ? *colorOverride : batch.Color;
+            StreamVertices(
+                batch.Vertices,
+                colorOverride,
+                4,
+                s_RenderBezierCurveData.MaxPoints,
+                s_RenderBezierCurveData.BezierVertexBufferPtr,
+                s_RenderBezierCurveData.Count,
+                &Renderer::FlushAndResetBezierCurves);
+        }
 
-        glDrawElements(GL_LINES, s_RenderTorusData.TorusVertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+        //the style tables are small, each goes up in one call
+        glm::vec4 colors[RenderPointData::TypeCount * 2];
+        float sizes[RenderPointData::TypeCount];
+        for (int type = 0; type < s_RenderPointData.TypeCount; type++)
+        {
+            colors[type * 2] = colorOverride ? *colorOverride : s_RenderPointData.Colors[type * 2];
+            colors[type * 2 + 1] = colorOverride ? *colorOverride : s_RenderPointData.Colors[type * 2 + 1];
+            sizes[type] = PointSize * s_RenderPointData.SizeScales[type];
+        }
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        auto& pointShader = s_RenderPointData.Shader;
+        pointShader->Bind();
+        pointShader->SetFloat4Array("u_Colors", colors, s_RenderPointData.TypeCount * 2);
+        pointShader->SetFloatArray("u_Sizes", sizes, s_RenderPointData.TypeCount);
+
+        StreamVertices(
+            s_CommandList.GetPoints(),
+            colorOverride,
+            1,
+            s_RenderPointData.MaxPoints,
+            s_RenderPointData.PointVertexBufferPtr,
+            s_RenderPointData.Count,
+            &Renderer::FlushAndResetPoints);
+
+        StreamVertices(
+            s_CommandList.GetLines(),
+            colorOverride,
+            2,
+            s_RenderLineData.MaxLines,
+            s_RenderLineData.LinesVertexBufferPtr,
+            s_RenderLineData.Count,
+            &Renderer::FlushAndResetLines);
+
+        //the flushes bind their own shaders
+        s_BoundShader = nullptr;
     }
 
-    void Renderer::RenderGrid(const Ref<OpenGLVertexArray>& vertexArray, const glm::mat4& transform, const glm::vec4& color)
+    void Renderer::BindShader(const Ref<OpenGLShader>& shader)
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        if (s_BoundShader == shader.get())
+            return;
 
-        auto shader = s_ShaderLibrary->Get("FlatColorShader");
         shader->Bind();
         shader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-        shader->SetMat4("u_ModelMatrix", transform);
-        shader->SetFloat4("u_Color", color);
-
-        vertexArray->Bind();
-        glDrawElements(GL_LINES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        s_BoundShader = shader.get();
     }
 
-    void Renderer::RenderPoint(const glm::vec3& position, const glm::vec4& color)
+    void Renderer::SetPolygonMode(unsigned int polygonMode)
     {
-        if (!ShowPoints)
+        if (s_PolygonMode == polygonMode)
             return;
 
-        if (s_RenderPointData.Count >= s_RenderPointData.MaxPoints)
-            FlushAndResetPoints();
+        glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+        s_PolygonMode = polygonMode;
+    }
 
-        s_RenderPointData.PointVertexBufferPtr->Position = position;
-        s_RenderPointData.PointVertexBufferPtr->Color = color;
-        s_RenderPointData.PointVertexBufferPtr++;
+    void Renderer::ExecuteCommand(const RenderCommand& command, const glm::vec4& color)
+    {
+        switch (command.Type)
+        {
+            case RenderCommandType::Torus:
+            case RenderCommandType::TrimmedTorus:
+            {
+                auto& shader = s_RenderTorusData.TorusShader;
+                BindShader(shader);
+                SetPolygonMode(GL_LINE);
+
+                shader->SetMat4("u_ModelMatrix", command.Transform);
+                shader->SetFloat4("u_Color", color);
+                shader->SetBool("isTrimmed", command.IsTrimmed);
+                if (command.IsTrimmed)
+                {
+                    shader->SetBool("reverseTrimming", command.ReverseTrimming);
+                    shader->SetInt("trimmingSampler", 0);
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, command.TextureId);
+                }
+
+                command.VertexArray->Bind();
+                glDrawElements(GL_LINES, command.VertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+                s_Stats.DrawCalls++;
+                break;
+            }
+            case RenderCommandType::BezierPatch:
+            {
+                ExecutePatch(
+                    command,
+                    &s_CommandList.GetVertices()[command.FirstVertex],
+                    &s_CommandList.GetIndices()[command.FirstIndex],
+                    color,
+                    s_RenderBezierPatchData.BezierPatchShader,
+                    s_RenderBezierPatchData.BezierPatchVertexArray,
+                    s_RenderBezierPatchData.BezierPatchVertexBuffer,
+                    s_RenderBezierPatchData.BezierPatchIndexBuffer);
+                break;
+            }
+            case RenderCommandType::BSplinePatch:
+            {
+                ExecutePatch(
+                    command,
+                    &s_CommandList.GetVertices()[command.FirstVertex],
+                    &s_CommandList.GetIndices()[command.FirstIndex],
+                    color,
+                    s_RenderBSplinePatchData.BSplinePatchShader,
+                    s_RenderBSplinePatchData.BSplinePatchVertexArray,
+                    s_RenderBSplinePatchData.BSplinePatchVertexBuffer,
+                    s_RenderBSplinePatchData.BSplinePatchIndexBuffer);
+                break;
+            }
+            case RenderCommandType::GregoryPatches:
+            {
+                auto& shader = s_RenderGregoryPatch.GregoryShader;
+                BindShader(shader);
+
+                s_RenderGregoryPatch.GregoryVertexArray->Bind();
+                s_RenderGregoryPatch.GregoryVertexBuffer->SetData(&s_CommandList.GetVertices()[command.FirstVertex], command.VertexCount * sizeof(glm::vec3));
+                s_Stats.BytesUploaded += command.VertexCount * sizeof(glm::vec3);
+
+                shader->SetFloat4("u_Color", color);
+                shader->SetInt("u_UDivisionCount", command.USubdivisionCount);
+                shader->SetInt("u_VDivisionCount", command.VSubdivisionCount);
+                shader->SetInt("u_ChunkCount", s_RenderGregoryPatch.ChunkCount);
+
+                //instances cover both isoline directions and every chunk of each line
+                glPatchParameteri(GL_PATCH_VERTICES, s_RenderGregoryPatch.PointsPerPatch);
+                glDrawArraysInstanced(GL_PATCHES, 0, command.VertexCount, 2 * s_RenderGregoryPatch.ChunkCount);
+                s_Stats.DrawCalls++;
+                break;
+            }
+            case RenderCommandType::Grid:
+            {
+                auto& shader = s_RenderGridData.GridShader;
+                BindShader(shader);
+                SetPolygonMode(GL_FILL);
+
+                shader->SetMat4("u_InverseViewProjectionMatrix", glm::inverse(s_SceneData->ViewProjectionMatrix));
+                shader->SetFloat4("u_Color", color);
+                shader->SetFloat("u_CellSize", s_RenderGridData.CellSize);
+                shader->SetFloat("u_MinPixelsBetweenCells", s_RenderGridData.MinPixelsBetweenCells);
+
+                //full screen quad, the y = 0 plane and its lines are found per pixel in the fragment shader
+                //the grid is depth tested but does not write depth so it never hides what is drawn after it
+                glDepthMask(GL_FALSE);
+                s_RenderGridData.GridVertexArray->Bind();
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                glDepthMask(GL_TRUE);
+                s_Stats.DrawCalls++;
+                break;
+            }
+            case RenderCommandType::LineStrip:
+            {
+                auto& shader = s_RenderLineStripData.Shader;
+                BindShader(shader);
+
+                shader->SetMat4("u_ModelMatrix", glm::mat4(1.0f));
+                shader->SetFloat4("u_Color", color);
+
+                command.VertexArray->Bind();
+                glDisable(GL_DEPTH_TEST);
+                glDrawArrays(GL_LINE_STRIP, 0, command.VertexCount);
+                glEnable(GL_DEPTH_TEST);
+                s_Stats.DrawCalls++;
+                break;
+            }
+            case RenderCommandType::ScreenQuad:
+            case RenderCommandType::ScreenQuadBorder:
+            {
+                const auto& bottomLeft = s_CommandList.GetVertices()[command.FirstVertex];
+                const auto& topRight = s_CommandList.GetVertices()[command.FirstVertex + 1];
+                float vertices[] =
+                {
+                    bottomLeft.x,bottomLeft.y,
+                    topRight.x,bottomLeft.y,
+                    topRight.x,topRight.y,
+                    bottomLeft.x,topRight.y
+                };
+
+                auto& shader = s_RenderSelectionBoxData.BoxShader;
+                shader->Bind();
+                s_BoundShader = shader.get();
+                SetPolygonMode(command.Type == RenderCommandType::ScreenQuad ? GL_FILL : GL_LINE);
+
+                s_RenderSelectionBoxData.BoxVertexArray->Bind();
+                s_RenderSelectionBoxData.BoxVertexBuffer->SetData(vertices, sizeof(vertices));
+                s_Stats.BytesUploaded += sizeof(vertices);
+                shader->SetFloat4("u_Color", color);
+
+                glDisable(GL_DEPTH_TEST);
+                glDrawElements(GL_TRIANGLES, s_RenderSelectionBoxData.BoxIndexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+                glEnable(GL_DEPTH_TEST);
+                s_Stats.DrawCalls++;
+                break;
+            }
+        }
+    }
 
-        s_RenderPointData.Count++;
+    Ref<OpenGLShader> Renderer::GetShader(const std::string& name)
+    {
+        return s_ShaderLibrary->Get(name);
     }
 
-    void Renderer::RenderLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color)
+    bool Renderer::IsVisible(const BoundingBox& boundingBox)
     {
-        if (s_RenderLineData.Count >= s_RenderLineData.MaxLines)
-            FlushAndResetLines();
+        if (s_SceneData->IsStereo && s_SceneData->SecondViewFrustum.Intersects(boundingBox))
+            return true;
 
-        s_RenderLineData.LinesVertexBufferPtr->Position = start;
-        s_RenderLineData.LinesVertexBufferPtr->Color = color;
-        s_RenderLineData.LinesVertexBufferPtr++;
+        return s_SceneData->ViewFrustum.Intersects(boundingBox);
+    }
 
-        s_RenderLineData.Count++;
+    void Renderer::RenderTorus(
+        const Ref<OpenGLVertexArray>& vertexArray,
+        const glm::mat4& transform,
+        const glm::vec4& color)
+    {
+        auto& command = s_CommandList.AddCommand(RenderCommandType::Torus, RenderLayer::Opaque);
+        command.VertexArray = vertexArray.get();
+        command.Transform = transform;
+        command.Color = color;
+    }
 
-        s_RenderLineData.LinesVertexBufferPtr->Position = end;
-        s_RenderLineData.LinesVertexBufferPtr->Color = color;
-        s_RenderLineData.LinesVertexBufferPtr++;
+    void Renderer::RenderTrimmedTorus(
+        const Ref<OpenGLVertexArray>& vertexArray,
+        const bool reverseTrimming,
+        const unsigned int textureId,
+        const glm::mat4& transform,
+        const glm::vec4& color)
+    {
+        auto& command = s_CommandList.AddCommand(RenderCommandType::TrimmedTorus, RenderLayer::Opaque, textureId);
+        command.VertexArray = vertexArray.get();
+        command.Transform = transform;
+        command.Color = color;
+        command.IsTrimmed = true;
+        command.ReverseTrimming = reverseTrimming;
+        command.TextureId = textureId;
+    }
 
-        s_RenderLineData.Count++;
+    void Renderer::RenderGrid(const glm::vec4& color)
+    {
+        auto& command = s_CommandList.AddCommand(RenderCommandType::Grid, RenderLayer::Grid);
+        command.Color = color;
     }
 
-    void Renderer::RenderScreenQuad(const glm::vec2& bottomLeft, const glm::vec2& topRight, const glm::vec4& color)
+    void Renderer::RenderLineStrip(const Ref<OpenGLVertexArray>& vertexArray, uint32_t vertexCount, const glm::vec4& color)
     {
-        glDisable(GL_DEPTH_TEST);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        float vertices[] =
-        {
-            bottomLeft.x,bottomLeft.y,
-            topRight.x,bottomLeft.y,
-            topRight.x,topRight.y,
-            bottomLeft.x,topRight.y
-        };
+        if (vertexCount < 2)
+            return;
 
-        s_RenderSelectionBoxData.BoxVertexArray->Bind();
-        s_RenderSelectionBoxData.BoxVertexBuffer->SetData(vertices, sizeof(vertices));
-        s_RenderSelectionBoxData.BoxShader->Bind();
-        s_RenderSelectionBoxData.BoxShader->SetFloat4("u_Color", color);
+        auto& command = s_CommandList.AddCommand(RenderCommandType::LineStrip, RenderLayer::Overlay);
+        command.VertexArray = vertexArray.get();
+        command.VertexCount = vertexCount;
+        command.Color = color;
+    }
 
-        glDrawElements(GL_TRIANGLES, s_RenderSelectionBoxData.BoxIndexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+    void Renderer::RenderPoint(const glm::vec3& position, uint8_t state)
+    {
+        if (!ShowPoints)
+            return;
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glEnable(GL_DEPTH_TEST);
+        s_CommandList.AddPoint(position, state);
+    }
 
+    void Renderer::SetPointStyle(PointType type, const glm::vec4& color, const glm::vec4& selectedColor, float sizeScale)
+    {
+        int index = (int)type;
+        s_RenderPointData.Colors[index * 2] = color;
+        s_RenderPointData.Colors[index * 2 + 1] = selectedColor;
+        s_RenderPointData.SizeScales[index] = sizeScale;
     }
 
-    void Renderer::RenderScreenQuadBorder(const glm::vec2& bottomLeft, const glm::vec2& topRight, const glm::vec4& color)
+    void Renderer::RenderLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color)
     {
-        glDisable(GL_DEPTH_TEST);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        float vertices[] =
-        {
-            bottomLeft.x,bottomLeft.y,
-            topRight.x,bottomLeft.y,
-            topRight.x,topRight.y,
-            bottomLeft.x,topRight.y
-        };
+        s_CommandList.AddLine(start, end, color);
+    }
 
-        s_RenderSelectionBoxData.BoxVertexArray->Bind();
-        s_RenderSelectionBoxData.BoxVertexBuffer->SetData(vertices, sizeof(vertices));
-        s_RenderSelectionBoxData.BoxShader->Bind();
-        s_RenderSelectionBoxData.BoxShader->SetFloat4("u_Color", color);
+    void Renderer::RenderScreenQuad(const glm::vec2& bottomLeft, const glm::vec2& topRight, const glm::vec4& color)
+    {
+        glm::vec3 corners[] = { glm::vec3(bottomLeft, 0.0f), glm::vec3(topRight, 0.0f) };
 
-        glDrawElements(GL_TRIANGLES, s_RenderSelectionBoxData.BoxIndexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+        auto& command = s_CommandList.AddCommand(RenderCommandType::ScreenQuad, RenderLayer::Overlay);
+        command.FirstVertex = s_CommandList.AddVertices(corners, 2);
+        command.VertexCount = 2;
+        command.Color = color;
+    }
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glEnable(GL_DEPTH_TEST);
+    void Renderer::RenderScreenQuadBorder(const glm::vec2& bottomLeft, const glm::vec2& topRight, const glm::vec4& color)
+    {
+        glm::vec3 corners[] = { glm::vec3(bottomLeft, 0.0f), glm::vec3(topRight, 0.0f) };
 
+        auto& command = s_CommandList.AddCommand(RenderCommandType::ScreenQuadBorder, RenderLayer::Overlay);
+        command.FirstVertex = s_CommandList.AddVertices(corners, 2);
+        command.VertexCount = 2;
+        command.Color = color;
     }
 
     void Renderer::RenderBezierC0(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color, float tolerance)
@@ -534,29 +815,16 @@ namespace CADMageddon
 
     void Renderer::ShaderRenderBezierC0(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color)
     {
-        float vertices[] = { p0.x,p0.y,p0.z,p1.x,p1.y,p1.z,p2.x,p2.y,p2.z };
-
-        s_RenderBezierCurveData.BezierVertexArray->Bind();
-        s_RenderBezierCurveData.BezierVertexBuffer->SetData(vertices, sizeof(float) * 9);
-        s_RenderBezierCurveData.QuadraticBezierShader->Bind();
-        s_RenderBezierCurveData.QuadraticBezierShader->SetFloat4("u_Color", color);
-        s_RenderBezierCurveData.QuadraticBezierShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-
-        glDrawArrays(GL_TRIANGLES, 0, 3);
+        //degree elevation gives the same curve as a cubic so it can share the cubic batch
+        glm::vec3 c1 = p0 + 2.0f / 3.0f * (p1 - p0);
+        glm::vec3 c2 = p2 + 2.0f / 3.0f * (p1 - p2);
 
+        Renderer::ShaderRenderBezierC0(p0, c1, c2, p2, color);
     }
 
     void Renderer::ShaderRenderBezierC0(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, const glm::vec4& color)
     {
-        float vertices[] = { p0.x,p0.y,p0.z,p1.x,p1.y,p1.z,p2.x,p2.y,p2.z,p3.x,p3.y,p3.z };
-
-        s_RenderBezierCurveData.BezierVertexArray->Bind();
-        s_RenderBezierCurveData.BezierVertexBuffer->SetData(vertices, sizeof(float) * 12);
-        s_RenderBezierCurveData.CubicBezierShader->Bind();
-        s_RenderBezierCurveData.CubicBezierShader->SetFloat4("u_Color", color);
-        s_RenderBezierCurveData.CubicBezierShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-
-        glDrawArrays(GL_LINES_ADJACENCY, 0, 4);
+        s_CommandList.AddBezierSegment(p0, p1, p2, p3, color);
     }
 
     void Renderer::RenderBezierPatch(
@@ -572,71 +840,19 @@ namespace CADMageddon
         bool reverseTrimming,
         const glm::vec4& color)
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-        s_RenderBezierPatchData.BezierPatchShader->Bind();
-        s_RenderBezierPatchData.BezierPatchVertexArray->Bind();
-        s_RenderBezierPatchData.BezierPatchVertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
-        s_RenderBezierPatchData.BezierPatchIndexBuffer->SetIndices(indices.data(), indices.size());
-
-
-        int columnRendered = 0;
-        int rowsRendered = 0;
-        float deltaColumn = 1.0f / patchCountx;
-        float deltaRow = 1.0f / patchCounty;
-
-        for (int i = 0; i < indices.size(); i += 64)
-        {
-            s_RenderBezierPatchData.BezierPatchShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat4("u_Color", color);
-            s_RenderBezierPatchData.BezierPatchShader->SetBool("isTrimmed", isTrimmed);
-            s_RenderBezierPatchData.BezierPatchShader->SetBool("u_ReverseTexture", false);
-            if (isTrimmed)
-            {
-                s_RenderBezierPatchData.BezierPatchShader->SetBool("reverseTrimming", reverseTrimming);
-                s_RenderBezierPatchData.BezierPatchShader->SetInt("trimmingSampler", 0);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, textureId);
-            }
-
-            glPatchParameteri(GL_PATCH_VERTICES, 16);
-
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_SubdivisionCount", vSubdivisonCount);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_uTexMin", columnRendered * deltaColumn);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_uTexMax", (columnRendered + 1) * deltaColumn);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_vTexMin", (rowsRendered)*deltaRow);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_vTexMax", (rowsRendered + 1) * deltaRow);
-
-            glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)(i * sizeof(GLuint)));
-
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_vTexMin", (rowsRendered + 1) * deltaRow);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_vTexMax", rowsRendered * deltaRow);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_SubdivisionCount", 1);
-            glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)((i + 16) * sizeof(GLuint)));
-
-
-            s_RenderBezierPatchData.BezierPatchShader->SetBool("u_ReverseTexture", true);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_uTexMin", columnRendered * deltaColumn);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_uTexMax", (columnRendered + 1) * deltaColumn);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_vTexMin", (rowsRendered)*deltaRow);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_vTexMax", (rowsRendered + 1) * deltaRow);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_SubdivisionCount", uSubdivisionCount);
-            glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)((i + 32) * sizeof(GLuint)));
-
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_uTexMin", (columnRendered + 1) * deltaColumn);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_uTexMax", (columnRendered)*deltaColumn);
-            s_RenderBezierPatchData.BezierPatchShader->SetFloat("u_SubdivisionCount", 1);
-            glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)((i + 48) * sizeof(GLuint)));
-
-            columnRendered++;
-            if (columnRendered == patchCountx)
-            {
-                columnRendered = 0;
-                rowsRendered++;
-            }
-        }
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        auto& command = s_CommandList.AddCommand(RenderCommandType::BezierPatch, RenderLayer::Opaque, isTrimmed ? textureId : 0);
+        command.FirstVertex = s_CommandList.AddVertices(vertices.data(), vertices.size());
+        command.VertexCount = vertices.size();
+        command.FirstIndex = s_CommandList.AddIndices(indices.data(), indices.size());
+        command.IndexCount = indices.size();
+        command.USubdivisionCount = uSubdivisionCount;
+        command.VSubdivisionCount = vSubdivisonCount;
+        command.PatchCountX = patchCountx;
+        command.PatchCountY = patchCounty;
+        command.IsTrimmed = isTrimmed;
+        command.TextureId = textureId;
+        command.ReverseTrimming = reverseTrimming;
+        command.Color = color;
     }
 
     void Renderer::RenderBSplinePatch(
@@ -652,174 +868,118 @@ namespace CADMageddon
         bool reverseTrimming,
         const glm::vec4& color)
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        auto& command = s_CommandList.AddCommand(RenderCommandType::BSplinePatch, RenderLayer::Opaque, isTrimmed ? textureId : 0);
+        command.FirstVertex = s_CommandList.AddVertices(vertices.data(), vertices.size());
+        command.VertexCount = vertices.size();
+        command.FirstIndex = s_CommandList.AddIndices(indices.data(), indices.size());
+        command.IndexCount = indices.size();
+        command.USubdivisionCount = uSubdivisionCount;
+        command.VSubdivisionCount = vSubdivisonCount;
+        command.PatchCountX = patchCountx;
+        command.PatchCountY = patchCounty;
+        command.IsTrimmed = isTrimmed;
+        command.TextureId = textureId;
+        command.ReverseTrimming = reverseTrimming;
+        command.Color = color;
+    }
 
-        s_RenderBSplinePatchData.BSplinePatchShader->Bind();
-        s_RenderBSplinePatchData.BSplinePatchVertexArray->Bind();
-        s_RenderBSplinePatchData.BSplinePatchVertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
-        s_RenderBSplinePatchData.BSplinePatchIndexBuffer->SetIndices(indices.data(), indices.size());
+    void Renderer::ExecutePatch(
+        const RenderCommand& command,
+        const glm::vec3* vertices,
+        const uint32_t* indices,
+        const glm::vec4& color,
+        const Ref<OpenGLShader>& shader,
+        const Ref<OpenGLVertexArray>& vertexArray,
+        const Ref<OpenGLVertexBuffer>& vertexBuffer,
+        const Ref<OpenGLIndexBuffer>& indexBuffer)
+    {
+        if (command.IndexCount == 0)
+            return;
 
-        int columnRendered = 0;
-        int rowsRendered = 0;
-        float deltaColumn = 1.0f / patchCountx;
-        float deltaRow = 1.0f / patchCounty;
+        BindShader(shader);
+        SetPolygonMode(GL_LINE);
 
-        for (int i = 0; i < indices.size(); i += 64)
+        vertexArray->Bind();
+        vertexBuffer->SetData(vertices, command.VertexCount * sizeof(Vertex));
+        indexBuffer->SetIndices(indices, command.IndexCount);
+        s_Stats.BytesUploaded += command.VertexCount * sizeof(Vertex) + command.IndexCount * sizeof(uint32_t);
+
+        shader->SetFloat4("u_Color", color);
+        shader->SetBool("isTrimmed", command.IsTrimmed);
+        if (command.IsTrimmed)
         {
-            s_RenderBSplinePatchData.BSplinePatchShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat4("u_Color", color);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetBool("isTrimmed", isTrimmed);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetBool("u_ReverseTexture", false);
-            if (isTrimmed)
-            {
-                s_RenderBSplinePatchData.BSplinePatchShader->SetBool("reverseTrimming", reverseTrimming);
-                s_RenderBSplinePatchData.BSplinePatchShader->SetInt("trimmingSampler", 0);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, textureId);
-            }
+            shader->SetBool("reverseTrimming", command.ReverseTrimming);
+            shader->SetInt("trimmingSampler", 0);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, command.TextureId);
+        }
+
+        glPatchParameteri(GL_PATCH_VERTICES, 16);
 
-            glPatchParameteri(GL_PATCH_VERTICES, 16);
+        int columnRendered = 0;
+        int rowsRendered = 0;
+        float deltaColumn = 1.0f / command.PatchCountX;
+        float deltaRow = 1.0f / command.PatchCountY;
 
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_SubdivisionCount", vSubdivisonCount);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_uTexMin", columnRendered * deltaColumn);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_uTexMax", (columnRendered + 1) * deltaColumn);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_vTexMin", (rowsRendered)*deltaRow);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_vTexMax", (rowsRendered + 1) * deltaRow);
+        for (int i = 0; i < command.IndexCount; i += 64)
+        {
+            shader->SetBool("u_ReverseTexture", false);
+            shader->SetFloat("u_SubdivisionCount", command.VSubdivisionCount);
+            shader->SetFloat("u_uTexMin", columnRendered * deltaColumn);
+            shader->SetFloat("u_uTexMax", (columnRendered + 1) * deltaColumn);
+            shader->SetFloat("u_vTexMin", (rowsRendered)*deltaRow);
+            shader->SetFloat("u_vTexMax", (rowsRendered + 1) * deltaRow);
 
             glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)(i * sizeof(GLuint)));
 
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_vTexMin", (rowsRendered + 1) * deltaRow);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_vTexMax", rowsRendered * deltaRow);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_SubdivisionCount", 1);
+            shader->SetFloat("u_vTexMin", (rowsRendered + 1) * deltaRow);
+            shader->SetFloat("u_vTexMax", rowsRendered * deltaRow);
+            shader->SetFloat("u_SubdivisionCount", 1);
             glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)((i + 16) * sizeof(GLuint)));
 
-            
-            s_RenderBSplinePatchData.BSplinePatchShader->SetBool("u_ReverseTexture", true);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_uTexMin", columnRendered * deltaColumn);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_uTexMax", (columnRendered + 1) * deltaColumn);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_vTexMin", (rowsRendered)*deltaRow);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_vTexMax", (rowsRendered + 1) * deltaRow);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_SubdivisionCount", uSubdivisionCount);
+            shader->SetBool("u_ReverseTexture", true);
+            shader->SetFloat("u_uTexMin", columnRendered * deltaColumn);
+            shader->SetFloat("u_uTexMax", (columnRendered + 1) * deltaColumn);
+            shader->SetFloat("u_vTexMin", (rowsRendered)*deltaRow);
+            shader->SetFloat("u_vTexMax", (rowsRendered + 1) * deltaRow);
+            shader->SetFloat("u_SubdivisionCount", command.USubdivisionCount);
             glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)((i + 32) * sizeof(GLuint)));
 
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_uTexMin", (columnRendered + 1) * deltaColumn);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_uTexMax", (columnRendered)*deltaColumn);
-            s_RenderBSplinePatchData.BSplinePatchShader->SetFloat("u_SubdivisionCount", 1);
+            shader->SetFloat("u_uTexMin", (columnRendered + 1) * deltaColumn);
+            shader->SetFloat("u_uTexMax", (columnRendered)*deltaColumn);
+            shader->SetFloat("u_SubdivisionCount", 1);
             glDrawElements(GL_PATCHES, 16, GL_UNSIGNED_INT, (void*)((i + 48) * sizeof(GLuint)));
+            s_Stats.DrawCalls += 4;
 
             columnRendered++;
-            if (columnRendered == patchCountx)
+            if (columnRendered == command.PatchCountX)
             {
                 columnRendered = 0;
                 rowsRendered++;
             }
         }
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
 
-    void Renderer::RenderGregoryPatch(
-        const glm::vec3& p0,
-        const glm::vec3& e0_m,
-        const glm::vec3& e0_p,
-        const glm::vec3& f0_m,
-        const glm::vec3& f0_p,
-        const glm::vec3& p1,
-        const glm::vec3& e1_m,
-        const glm::vec3& e1_p,
-        const glm::vec3& f1_m,
-        const glm::vec3& f1_p,
-        const glm::vec3& p2,
-        const glm::vec3& e2_m,
-        const glm::vec3& e2_p,
-        const glm::vec3& f2_m,
-        const glm::vec3& f2_p,
-        const glm::vec3& p3,
-        const glm::vec3& e3_m,
-        const glm::vec3& e3_p,
-        const glm::vec3& f3_m,
-        const glm::vec3& f3_p,
+    void Renderer::RenderGregoryPatches(
+        const glm::vec3* controlPoints,
+        int patchCount,
         int uSubdivisionCount,
         int vSubdivisionCount,
         const glm::vec4& color)
     {
-        std::vector<float> uValues;
-        std::vector<float> vValues;
-
-        for (int i = 0; i < uSubdivisionCount; i++)
-            uValues.push_back(float(i) / float(uSubdivisionCount - 1));
-        for (int j = 0; j < vSubdivisionCount; j++)
-            vValues.push_back(float(j) / float(vSubdivisionCount - 1));
-
-        glm::vec3 controlPoints[20] =
-        {
-            p0,
-            e0_m,
-            e0_p,
-            f0_m,
-            f0_p,
-            p1,
-            e1_m,
-            e1_p,
-            f1_m,
-            f1_p,
-            p2,
-            e2_m,
-            e2_p,
-            f2_m,
-            f2_p,
-            p3,
-            e3_m,
-            e3_p,
-            f3_m,
-            f3_p
-        };
-
-        s_RenderGregoryPatch.GregoryVertexArray->Bind();
-        s_RenderGregoryPatch.GregoryVertexBuffer->SetData(uValues.data(), uValues.size() * sizeof(float));
-        s_RenderGregoryPatch.GregoryShader->Bind();
-        s_RenderGregoryPatch.GregoryShader->SetFloat4("u_Color", color);
-        s_RenderGregoryPatch.GregoryShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-        s_RenderGregoryPatch.GregoryShader->SetBool("isForward", true);
-        s_RenderGregoryPatch.GregoryShader->SetFloat3Array("gregoryPoints", controlPoints, 20);
-
-        glDrawArrays(GL_POINTS, 0, uValues.size());
-
-        s_RenderGregoryPatch.GregoryShader->SetBool("isForward", false);
-        s_RenderGregoryPatch.GregoryVertexBuffer->SetData(vValues.data(), vValues.size() * sizeof(float));
-
-        glDrawArrays(GL_POINTS, 0, vValues.size());
-    }
-
-    void Renderer::RenderGregoryPatch(
-        glm::vec3* data,
-        int uSubDivisionCount,
-        int vSubdivisionCount,
-        const glm::vec4& color)
-    {
-        std::vector<float> uValues;
-        std::vector<float> vValues;
-
-        for (int i = 0; i < uSubDivisionCount; i++)
-            uValues.push_back(float(i) / float(uSubDivisionCount - 1));
-        for (int j = 0; j < vSubdivisionCount; j++)
-            vValues.push_back(float(j) / float(vSubdivisionCount - 1));
-
-
-        s_RenderGregoryPatch.GregoryVertexArray->Bind();
-        s_RenderGregoryPatch.GregoryVertexBuffer->SetData(uValues.data(), uValues.size() * sizeof(float));
-        s_RenderGregoryPatch.GregoryShader->Bind();
-        s_RenderGregoryPatch.GregoryShader->SetFloat4("u_Color", color);
-        s_RenderGregoryPatch.GregoryShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-        s_RenderGregoryPatch.GregoryShader->SetBool("isForward", true);
-        s_RenderGregoryPatch.GregoryShader->SetFloat3Array("gregoryPoints", &data[0], 20);
-
-        glDrawArrays(GL_POINTS, 0, uValues.size());
+        if (patchCount <= 0)
+            return;
+        if (patchCount > s_RenderGregoryPatch.MaxPatches)
+            patchCount = s_RenderGregoryPatch.MaxPatches;
 
-        s_RenderGregoryPatch.GregoryShader->SetBool("isForward", false);
-        s_RenderGregoryPatch.GregoryVertexBuffer->SetData(vValues.data(), vValues.size() * sizeof(float));
+        uint32_t pointCount = patchCount * s_RenderGregoryPatch.PointsPerPatch;
 
-        glDrawArrays(GL_POINTS, 0, vValues.size());
+        auto& command = s_CommandList.AddCommand(RenderCommandType::GregoryPatches, RenderLayer::Opaque);
+        command.FirstVertex = s_CommandList.AddVertices(controlPoints, pointCount);
+        command.VertexCount = pointCount;
+        command.USubdivisionCount = std::max(uSubdivisionCount, 2);
+        command.VSubdivisionCount = std::max(vSubdivisionCount, 2);
+        command.Color = color;
     }
 
     void Renderer::RenderBSpline(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, const glm::vec4& color, bool snapToEnd)
@@ -858,6 +1018,7 @@ namespace CADMageddon
         glBindTexture(GL_TEXTURE_2D, textureId);
 
         glDrawElements(GL_TRIANGLES, s_RenderTextureQuadData.TextureQuadIndexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+        s_Stats.DrawCalls++;
     }
 
     float CADMageddon::Renderer::Spline(float t, float ti, float interval)
@@ -896,27 +1057,56 @@ namespace CADMageddon
             Spline3(t, 1 - interval), Spline3(t, 1));
     }
 
+    void Renderer::NextRegion(Ref<OpenGLVertexArray>& vertexArray, const Ref<OpenGLRingBuffer>& vertexBuffer, uint32_t divisor)
+    {
+        if (!vertexBuffer->NextRegion())
+            return;
+
+        //the ring grew into new storage instead of waiting for the GPU, the attributes have to point at it
+        vertexArray = CreateRef<OpenGLVertexArray>();
+        vertexArray->AddVertexBuffer(vertexBuffer, divisor);
+    }
+
     void Renderer::FlushAndResetPoints()
     {
-        uint32_t pointDataSize = (uint32_t)((uint8_t*)s_RenderPointData.PointVertexBufferPtr - (uint8_t*)s_RenderPointData.PointVertexBufferBase);
-        s_RenderPointData.PointsVertexBuffer->SetData(s_RenderPointData.PointVertexBufferBase, pointDataSize);
+        if (s_RenderPointData.Count == 0)
+            return;
+
+        //vertices were written straight into the mapped region, draw it and move on to the next one
         FlushPoints();
+        NextRegion(s_RenderPointData.PointsVertexArray, s_RenderPointData.PointsVertexBuffer, 1);
 
         s_RenderPointData.Count = 0;
+        s_RenderPointData.PointVertexBufferBase = (PointInstance*)s_RenderPointData.PointsVertexBuffer->GetRegionData();
         s_RenderPointData.PointVertexBufferPtr = s_RenderPointData.PointVertexBufferBase;
-
     }
 
     void Renderer::FlushAndResetLines()
     {
-        uint32_t lineDataSize = (uint32_t)((uint8_t*)s_RenderLineData.LinesVertexBufferPtr - (uint8_t*)s_RenderLineData.LinesVertexBufferBase);
-        s_RenderLineData.LinesVertexBuffer->SetData(s_RenderLineData.LinesVertexBufferBase, lineDataSize);
+        if (s_RenderLineData.Count == 0)
+            return;
+
         FlushLines();
+        NextRegion(s_RenderLineData.LinesVertexArray, s_RenderLineData.LinesVertexBuffer);
 
         s_RenderLineData.Count = 0;
+        s_RenderLineData.LinesVertexBufferBase = (VertexC*)s_RenderLineData.LinesVertexBuffer->GetRegionData();
         s_RenderLineData.LinesVertexBufferPtr = s_RenderLineData.LinesVertexBufferBase;
     }
 
+    void Renderer::FlushAndResetBezierCurves()
+    {
+        if (s_RenderBezierCurveData.Count == 0)
+            return;
+
+        FlushBezierCurves();
+        NextRegion(s_RenderBezierCurveData.BezierVertexArray, s_RenderBezierCurveData.BezierVertexBuffer);
+
+        s_RenderBezierCurveData.Count = 0;
+        s_RenderBezierCurveData.BezierVertexBufferBase = (Vertex*)s_RenderBezierCurveData.BezierVertexBuffer->GetRegionData();
+        s_RenderBezierCurveData.BezierVertexBufferPtr = s_RenderBezierCurveData.BezierVertexBufferBase;
+    }
+
     void Renderer::FlushPoints()
     {
         if (s_RenderPointData.Count == 0)
@@ -926,7 +1116,16 @@ namespace CADMageddon
         s_RenderPointData.Shader->Bind();
         s_RenderPointData.Shader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
 
-        glDrawArrays(GL_POINTS, 0, s_RenderPointData.Count);
+        //sprite sizes are in pixels, the bound framebuffer sets the viewport
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        s_RenderPointData.Shader->SetFloat2("u_ViewportSize", glm::vec2(viewport[2], viewport[3]));
+
+        int firstInstance = s_RenderPointData.PointsVertexBuffer->GetRegionOffset() / sizeof(PointInstance);
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, s_RenderPointData.Count, firstInstance);
+        s_Stats.DrawCalls++;
+        //the ring buffer is written through the persistent mapping, this is what reaches the GPU
+        s_Stats.BytesUploaded += s_RenderPointData.Count * sizeof(PointInstance);
     }
 
     void Renderer::FlushLines()
@@ -940,8 +1139,281 @@ namespace CADMageddon
 
 
         glDisable(GL_DEPTH_TEST);
-        glDrawArrays(GL_LINES, 0, s_RenderLineData.Count);
+        int firstVertex = s_RenderLineData.LinesVertexBuffer->GetRegionOffset() / sizeof(VertexC);
+        glDrawArrays(GL_LINES, firstVertex, s_RenderLineData.Count);
+        s_Stats.DrawCalls++;
+        s_Stats.BytesUploaded += s_RenderLineData.Count * sizeof(VertexC);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    void Renderer::FlushBezierCurves()
+    {
+        if (s_RenderBezierCurveData.Count == 0)
+            return;
+
+        s_RenderBezierCurveData.BezierVertexArray->Bind();
+        s_RenderBezierCurveData.CubicBezierShader->Bind();
+        s_RenderBezierCurveData.CubicBezierShader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
+        s_RenderBezierCurveData.CubicBezierShader->SetFloat4("u_Color", s_RenderBezierCurveData.Color);
+
+        int firstVertex = s_RenderBezierCurveData.BezierVertexBuffer->GetRegionOffset() / sizeof(Vertex);
+        glDrawArrays(GL_LINES_ADJACENCY, firstVertex, s_RenderBezierCurveData.Count);
+        s_Stats.DrawCalls++;
+        s_Stats.BytesUploaded += s_RenderBezierCurveData.Count * sizeof(Vertex);
+    }
+
+    void Renderer::BeginPickingScene(const glm::mat4& viewProjectionMatrix)
+    {
+        s_SceneData->ViewProjectionMatrix = viewProjectionMatrix;
+        s_SceneData->ViewFrustum = Frustum(viewProjectionMatrix);
+        s_SceneData->IsStereo = false;
+
+        //shaders write colors to location 0 and ids to location 1, only the ids reach a buffer
+        const GLenum drawBuffers[] = { GL_NONE, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, drawBuffers);
+
+        const GLuint backgroundId[] = { 0, 0, 0, 0 };
+        glClearBufferuiv(GL_COLOR, 1, backgroundId);
+
+        s_BoundShader = nullptr;
+        glClear(GL_DEPTH_BUFFER_BIT);
+
+        s_RenderPickingData.PointVertexBufferPtr = s_RenderPickingData.PointVertexBufferBase;
+        s_RenderPickingData.PointCount = 0;
+
+        s_RenderPickingData.LinesVertexBufferPtr = s_RenderPickingData.LinesVertexBufferBase;
+        s_RenderPickingData.LineCount = 0;
+    }
+
+    void Renderer::EndPickingScene()
+    {
+        FlushAndResetPickingLines();
+
+        //points go last without depth test so they win over curves and surfaces passing through them
+        glDisable(GL_DEPTH_TEST);
+        FlushAndResetPickingPoints();
         glEnable(GL_DEPTH_TEST);
+
+        s_BoundShader = nullptr;
+        SetPolygonMode(GL_FILL);
+
+        GLenum drawBuffer = GL_COLOR_ATTACHMENT0;
+        glDrawBuffers(1, &drawBuffer);
+    }
+
+    void Renderer::RenderPickingPoint(const glm::vec3& position, uint32_t id)
+    {
+        if (s_RenderPickingData.PointCount >= s_RenderPickingData.MaxPoints)
+            FlushAndResetPickingPoints();
+
+        s_RenderPickingData.PointVertexBufferPtr->Position = position;
+        s_RenderPickingData.PointVertexBufferPtr->Id = id;
+        s_RenderPickingData.PointVertexBufferPtr++;
+
+        s_RenderPickingData.PointCount++;
+    }
+
+    void Renderer::RenderPickingLine(const glm::vec3& start, const glm::vec3& end, uint32_t id)
+    {
+        if (s_RenderPickingData.LineCount + 2 > s_RenderPickingData.MaxLines)
+            FlushAndResetPickingLines();
+
+        s_RenderPickingData.LinesVertexBufferPtr->Position = start;
+        s_RenderPickingData.LinesVertexBufferPtr->Id = id;
+        s_RenderPickingData.LinesVertexBufferPtr++;
+
+        s_RenderPickingData.LinesVertexBufferPtr->Position = end;
+        s_RenderPickingData.LinesVertexBufferPtr->Id = id;
+        s_RenderPickingData.LinesVertexBufferPtr++;
+
+        s_RenderPickingData.LineCount += 2;
+    }
+
+    void Renderer::RenderPickingMesh(const Ref<OpenGLVertexArray>& vertexArray, const glm::mat4& transform, uint32_t id)
+    {
+        s_RenderPickingData.Shader->Bind();
+        s_RenderPickingData.Shader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
+        s_RenderPickingData.Shader->SetMat4("u_ModelMatrix", transform);
+        s_RenderPickingData.Shader->SetBool("u_UseVertexId", false);
+        s_RenderPickingData.Shader->SetInt("u_Id", id);
+
+        vertexArray->Bind();
+        glDrawElements(GL_LINES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+        s_Stats.DrawCalls++;
+    }
+
+    void Renderer::RenderPickingBezier(const std::vector<glm::vec3>& controlPoints, uint32_t id)
+    {
+        auto& shader = s_RenderBezierCurveData.CubicBezierShader;
+        shader->Bind();
+        shader->SetInt("u_Id", id);
+
+        auto addSegment = [](const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3)
+        {
+            if (s_RenderBezierCurveData.Count + 4 > s_RenderBezierCurveData.MaxPoints)
+                FlushAndResetBezierCurves();
+
+            for (const auto& point : { p0, p1, p2, p3 })
+            {
+                s_RenderBezierCurveData.BezierVertexBufferPtr->Position = point;
+                s_RenderBezierCurveData.BezierVertexBufferPtr++;
+            }
+
+            s_RenderBezierCurveData.Count += 4;
+        };
+
+        //trailing quadratic and linear segments are raised to cubics, same as in ShaderRenderBezierC0
+        for (int i = 0; i + 1 < controlPoints.size(); i += 3)
+        {
+            const auto& p0 = controlPoints[i];
+            if (i + 3 < controlPoints.size())
+            {
+                addSegment(p0, controlPoints[i + 1], controlPoints[i + 2], controlPoints[i + 3]);
+            }
+            else if (i + 2 < controlPoints.size())
+            {
+                const auto& p1 = controlPoints[i + 1];
+                const auto& p2 = controlPoints[i + 2];
+                addSegment(p0, p0 + 2.0f / 3.0f * (p1 - p0), p2 + 2.0f / 3.0f * (p1 - p2), p2);
+            }
+            else
+            {
+                const auto& p1 = controlPoints[i + 1];
+                addSegment(p0, glm::mix(p0, p1, 1.0f / 3.0f), glm::mix(p0, p1, 2.0f / 3.0f), p1);
+            }
+        }
+
+        FlushAndResetBezierCurves();
+    }
+
+    void Renderer::RenderPickingBezierPatch(
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<uint32_t>& indices,
+        float uSubdivisionCount,
+        float vSubdivisionCount,
+        int patchCountx,
+        int patchCounty,
+        bool isTrimmed,
+        unsigned int textureId,
+        bool reverseTrimming,
+        uint32_t id)
+    {
+        RenderCommand command;
+        command.VertexCount = vertices.size();
+        command.IndexCount = indices.size();
+        command.USubdivisionCount = uSubdivisionCount;
+        command.VSubdivisionCount = vSubdivisionCount;
+        command.PatchCountX = patchCountx;
+        command.PatchCountY = patchCounty;
+        command.IsTrimmed = isTrimmed;
+        command.TextureId = textureId;
+        command.ReverseTrimming = reverseTrimming;
+
+        RenderPickingPatch(
+            command,
+            vertices,
+            indices,
+            id,
+            s_RenderBezierPatchData.BezierPatchShader,
+            s_RenderBezierPatchData.BezierPatchVertexArray,
+            s_RenderBezierPatchData.BezierPatchVertexBuffer,
+            s_RenderBezierPatchData.BezierPatchIndexBuffer);
+    }
+
+    void Renderer::RenderPickingBSplinePatch(
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<uint32_t>& indices,
+        float uSubdivisionCount,
+        float vSubdivisionCount,
+        int patchCountx,
+        int patchCounty,
+        bool isTrimmed,
+        unsigned int textureId,
+        bool reverseTrimming,
+        uint32_t id)
+    {
+        RenderCommand command;
+        command.VertexCount = vertices.size();
+        command.IndexCount = indices.size();
+        command.USubdivisionCount = uSubdivisionCount;
+        command.VSubdivisionCount = vSubdivisionCount;
+        command.PatchCountX = patchCountx;
+        command.PatchCountY = patchCounty;
+        command.IsTrimmed = isTrimmed;
+        command.TextureId = textureId;
+        command.ReverseTrimming = reverseTrimming;
+
+        RenderPickingPatch(
+            command,
+            vertices,
+            indices,
+            id,
+            s_RenderBSplinePatchData.BSplinePatchShader,
+            s_RenderBSplinePatchData.BSplinePatchVertexArray,
+            s_RenderBSplinePatchData.BSplinePatchVertexBuffer,
+            s_RenderBSplinePatchData.BSplinePatchIndexBuffer);
+    }
+
+    void Renderer::RenderPickingPatch(
+        const RenderCommand& command,
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<uint32_t>& indices,
+        uint32_t id,
+        const Ref<OpenGLShader>& shader,
+        const Ref<OpenGLVertexArray>& vertexArray,
+        const Ref<OpenGLVertexBuffer>& vertexBuffer,
+        const Ref<OpenGLIndexBuffer>& indexBuffer)
+    {
+        //the other picking draws bind their shaders directly
+        s_BoundShader = nullptr;
+        BindShader(shader);
+        shader->SetInt("u_Id", id);
+
+        ExecutePatch(command, vertices.data(), indices.data(), glm::vec4(1.0f), shader, vertexArray, vertexBuffer, indexBuffer);
+    }
+
+    void Renderer::FlushAndResetPickingPoints()
+    {
+        if (s_RenderPickingData.PointCount == 0)
+            return;
+
+        s_RenderPickingData.PointsVertexArray->Bind();
+        s_RenderPickingData.Shader->Bind();
+        s_RenderPickingData.Shader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
+        s_RenderPickingData.Shader->SetMat4("u_ModelMatrix", glm::mat4(1.0f));
+        s_RenderPickingData.Shader->SetBool("u_UseVertexId", true);
+
+        int firstVertex = s_RenderPickingData.PointsVertexBuffer->GetRegionOffset() / sizeof(VertexId);
+        glDrawArrays(GL_POINTS, firstVertex, s_RenderPickingData.PointCount);
+        s_Stats.DrawCalls++;
+        s_Stats.BytesUploaded += s_RenderPickingData.PointCount * sizeof(VertexId);
+        NextRegion(s_RenderPickingData.PointsVertexArray, s_RenderPickingData.PointsVertexBuffer);
+
+        s_RenderPickingData.PointCount = 0;
+        s_RenderPickingData.PointVertexBufferBase = (VertexId*)s_RenderPickingData.PointsVertexBuffer->GetRegionData();
+        s_RenderPickingData.PointVertexBufferPtr = s_RenderPickingData.PointVertexBufferBase;
+    }
+
+    void Renderer::FlushAndResetPickingLines()
+    {
+        if (s_RenderPickingData.LineCount == 0)
+            return;
+
+        s_RenderPickingData.LinesVertexArray->Bind();
+        s_RenderPickingData.Shader->Bind();
+        s_RenderPickingData.Shader->SetMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
+        s_RenderPickingData.Shader->SetMat4("u_ModelMatrix", glm::mat4(1.0f));
+        s_RenderPickingData.Shader->SetBool("u_UseVertexId", true);
+
+        int firstVertex = s_RenderPickingData.LinesVertexBuffer->GetRegionOffset() / sizeof(VertexId);
+        glDrawArrays(GL_LINES, firstVertex, s_RenderPickingData.LineCount);
+        s_Stats.DrawCalls++;
+        s_Stats.BytesUploaded += s_RenderPickingData.LineCount * sizeof(VertexId);
+        NextRegion(s_RenderPickingData.LinesVertexArray, s_RenderPickingData.LinesVertexBuffer);
+
+        s_RenderPickingData.LineCount = 0;
+        s_RenderPickingData.LinesVertexBufferBase = (VertexId*)s_RenderPickingData.LinesVertexBuffer->GetRegionData();
+        s_RenderPickingData.LinesVertexBufferPtr = s_RenderPickingData.LinesVertexBufferBase;
     }
 
     bool Renderer::IsBezierFlatEnough(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, float tolerance)
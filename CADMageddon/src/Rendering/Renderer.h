@@ -2,9 +2,44 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "Frustum.h"
 
 namespace CADMageddon
 {
+    struct RenderCommand;
+
+    //picks the color and size of a point sprite, the scene's own points are Control points
+    enum class PointType : uint8_t
+    {
+        Control = 0,
+        Virtual = 1,
+        Marker = 2
+    };
+
+    //packed into one byte per point, colors are looked up in the shader instead of being uploaded per point
+    enum PointState : uint8_t
+    {
+        PointStateSelected = 1 << 0,
+        PointStateVisible = 1 << 1,
+        PointStateTypeShift = 2
+    };
+
+    inline uint8_t PackPointState(PointType type, bool isSelected = false, bool isVisible = true)
+    {
+        return (uint8_t)(((uint8_t)type << PointStateTypeShift)
+            | (isSelected ? PointStateSelected : 0)
+            | (isVisible ? PointStateVisible : 0));
+    }
+
+    //accumulated until ResetStats, uploads count the vertex and index bytes written for streamed geometry
+    struct RenderStats
+    {
+        uint32_t DrawCalls = 0;
+        uint64_t BytesUploaded = 0;
+    };
+
+    // Render* calls record into a per-frame command list, nothing is drawn until the scene is submitted.
+    // Submitting sorts the draws by pipeline state and can be repeated, e.g. once for each stereo eye.
     class Renderer
     {
     public:
@@ -20,26 +55,37 @@ namespace CADMageddon
         static void OnWindowResize(uint32_t width, uint32_t height);
 
         static void BeginScene(const glm::mat4& viewProjectionMatrix);
+        //objects are culled against both eye frustums so the recorded frame can be submitted for either eye
+        static void BeginStereoScene(const glm::mat4& leftViewProjectionMatrix, const glm::mat4& rightViewProjectionMatrix);
         static void EndScene();
-        static void RenderGrid(const Ref<OpenGLVertexArray>& vertexArray, const glm::mat4& transform, const glm::vec4& color = DEFAULT_COLOR);
+        static void SubmitScene(const glm::mat4& viewProjectionMatrix);
+        //every recorded color is replaced by colorOverride, used for the anaglyph eyes
+        static void SubmitScene(const glm::mat4& viewProjectionMatrix, const glm::vec4& colorOverride);
+        static bool IsVisible(const BoundingBox& boundingBox);
+
+        static const RenderStats& GetStats() { return s_Stats; }
+        static void ResetStats() { s_Stats = RenderStats(); }
+
+        static Ref<OpenGLShader> GetShader(const std::string& name);
+        static void RenderGrid(const glm::vec4& color = DEFAULT_COLOR);
         static void RenderTorus(
-            const std::vector<glm::vec3>& vertices,
-            const std::vector<glm::vec2>& textureCoordinates,
-            const std::vector<uint32_t>& indices,
+            const Ref<OpenGLVertexArray>& vertexArray,
             const glm::mat4& transform,
             const glm::vec4& color = DEFAULT_COLOR);
 
         static void RenderTrimmedTorus(
-            const std::vector<glm::vec3>& vertices,
-            const std::vector<glm::vec2>& textureCoordinates,
+            const Ref<OpenGLVertexArray>& vertexArray,
             const bool reverseTrimming,
             const unsigned int textureId,
-            const std::vector<uint32_t>& indices,
             const glm::mat4& transform,
             const glm::vec4& color = DEFAULT_COLOR);
 
-        static void RenderPoint(const glm::vec3& position, const glm::vec4& color = DEFAULT_COLOR);
+        //points are drawn as instanced sprites, state comes from PackPointState and invisible points are dropped on the GPU
+        static void RenderPoint(const glm::vec3& position, uint8_t state = PointStateVisible);
+        static void SetPointStyle(PointType type, const glm::vec4& color, const glm::vec4& selectedColor, float sizeScale = 1.0f);
         static void RenderLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color = DEFAULT_COLOR);
+        //draws the first vertexCount positions of a static buffer as one strip, on top of the scene like the batched lines
+        static void RenderLineStrip(const Ref<OpenGLVertexArray>& vertexArray, uint32_t vertexCount, const glm::vec4& color = DEFAULT_COLOR);
 
         static void RenderScreenQuad(const glm::vec2& bottomLeft, const glm::vec2& topRight, const glm::vec4& color = DEFAULT_COLOR);
         static void RenderScreenQuadBorder(const glm::vec2& bottomLeft, const glm::vec2& topRight, const glm::vec4& color = DEFAULT_COLOR);
@@ -105,36 +151,12 @@ namespace CADMageddon
             bool reverseTrimming,
             const glm::vec4& color = DEFAULT_COLOR);
 
-        static void RenderGregoryPatch(
-            const glm::vec3& p0,
-            const glm::vec3& e0_m,
-            const glm::vec3& e0_p,
-            const glm::vec3& f0_m,
-            const glm::vec3& f0_p,
-            const glm::vec3& p1,
-            const glm::vec3& e1_m,
-            const glm::vec3& e1_p,
-            const glm::vec3& f1_m,
-            const glm::vec3& f1_p,
-            const glm::vec3& p2,
-            const glm::vec3& e2_m,
-            const glm::vec3& e2_p,
-            const glm::vec3& f2_m,
-            const glm::vec3& f2_p,
-            const glm::vec3& p3,
-            const glm::vec3& e3_m,
-            const glm::vec3& e3_p,
-            const glm::vec3& f3_m,
-            const glm::vec3& f3_p,
+        //controlPoints holds patchCount consecutive groups of 20 Gregory points, all patches are drawn with one call
+        static void RenderGregoryPatches(
+            const glm::vec3* controlPoints,
+            int patchCount,
             int uSubdivisionCount,
             int vSubdivisionCount,
-            const glm::vec4& color = DEFAULT_COLOR
-        );
-
-        static void RenderGregoryPatch(
-            glm::vec3* data,
-            int uSubDivisionCount,
-            int vSubdivisionCount,
             const glm::vec4& color = DEFAULT_COLOR);
 
         static void RenderBSpline(
@@ -147,8 +169,41 @@ namespace CADMageddon
 
         static void RenderTextureQuad(int textureId);
 
+        //picking pass, writes ids into color attachment 1 of the bound framebuffer instead of colors
+        static void BeginPickingScene(const glm::mat4& viewProjectionMatrix);
+        static void EndPickingScene();
+        static void RenderPickingPoint(const glm::vec3& position, uint32_t id);
+        static void RenderPickingLine(const glm::vec3& start, const glm::vec3& end, uint32_t id);
+        static void RenderPickingMesh(const Ref<OpenGLVertexArray>& vertexArray, const glm::mat4& transform, uint32_t id);
+        //curves and patches go through the same shaders as when they are drawn, only the id output is kept
+        static void RenderPickingBezier(const std::vector<glm::vec3>& controlPoints, uint32_t id);
+        static void RenderPickingBezierPatch(
+            const std::vector<glm::vec3>& vertices,
+            const std::vector<uint32_t>& indices,
+            float uSubdivisionCount,
+            float vSubdivisionCount,
+            int patchCountx,
+            int patchCounty,
+            bool isTrimmed,
+            unsigned int textureId,
+            bool reverseTrimming,
+            uint32_t id);
+        static void RenderPickingBSplinePatch(
+            const std::vector<glm::vec3>& vertices,
+            const std::vector<uint32_t>& indices,
+            float uSubdivisionCount,
+            float vSubdivisionCount,
+            int patchCountx,
+            int patchCounty,
+            bool isTrimmed,
+            unsigned int textureId,
+            bool reverseTrimming,
+            uint32_t id);
+
     private:
+        static void InitGridRenderData();
         static void InitTorusRenderData();
+        static void InitLineStripRenderData();
         static void InitPointRenderData();
         static void InitLineRenderData();
         static void InitBezierCurveRenderData();
@@ -157,12 +212,43 @@ namespace CADMageddon
         static void InitSelectionBoxRenderData();
         static void InitGregoryPatchRenderData();
         static void InitTextureQuadRenderData();
+        static void InitPickingRenderData();
+
+        static void SubmitCommands(const glm::mat4& viewProjectionMatrix, const glm::vec4* colorOverride);
+        static void SubmitBatches(const glm::vec4* colorOverride);
+        static void ExecuteCommand(const RenderCommand& command, const glm::vec4& color);
+        static void ExecutePatch(
+            const RenderCommand& command,
+            const glm::vec3* vertices,
+            const uint32_t* indices,
+            const glm::vec4& color,
+            const Ref<OpenGLShader>& shader,
+            const Ref<OpenGLVertexArray>& vertexArray,
+            const Ref<OpenGLVertexBuffer>& vertexBuffer,
+            const Ref<OpenGLIndexBuffer>& indexBuffer);
+        static void BindShader(const Ref<OpenGLShader>& shader);
+        static void SetPolygonMode(unsigned int polygonMode);
 
+        static void NextRegion(Ref<OpenGLVertexArray>& vertexArray, const Ref<OpenGLRingBuffer>& vertexBuffer, uint32_t divisor = 0);
         static void FlushAndResetPoints();
         static void FlushAndResetLines();
+        static void FlushAndResetBezierCurves();
 
         static void FlushPoints();
         static void FlushLines();
+        static void FlushBezierCurves();
+
+        static void FlushAndResetPickingPoints();
+        static void FlushAndResetPickingLines();
+        static void RenderPickingPatch(
+            const RenderCommand& command,
+            const std::vector<glm::vec3>& vertices,
+            const std::vector<uint32_t>& indices,
+            uint32_t id,
+            const Ref<OpenGLShader>& shader,
+            const Ref<OpenGLVertexArray>& vertexArray,
+            const Ref<OpenGLVertexBuffer>& vertexBuffer,
+            const Ref<OpenGLIndexBuffer>& indexBuffer);
 
         static float Spline(float t, float ti, float interval = 1.0f);
         static float Spline1(float t, float ti, float interval = 1.0f);
@@ -173,10 +259,14 @@ namespace CADMageddon
         struct SceneData
         {
             glm::mat4 ViewProjectionMatrix;
+            Frustum ViewFrustum;
+            Frustum SecondViewFrustum;
+            bool IsStereo = false;
         };
 
         static Scope<SceneData> s_SceneData;
         static Scope<ShaderLibrary> s_ShaderLibrary;
+        static RenderStats s_Stats;
 
         static bool IsBezierFlatEnough(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, float tolerance);
         static bool IsBezierFlatEnough(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float tolerance);
@@ -1,6 +1,7 @@
 #include "Shader.h"
 
 #include <fstream>
+#include <filesystem>
 #include <glad/glad.h>
 
 #include <glm/gtc/type_ptr.hpp>
@@ -25,18 +26,54 @@ namespace CADMageddon {
         return 0;
     }
 
-    OpenGLShader::OpenGLShader(const std::string& filepath)
+    //FNV-1a, unlike std::hash it is guaranteed to stay the same between runs
+    static uint64_t HashString(const std::string& value, uint64_t hash = 14695981039346656037ull)
     {
-        std::string source = ReadFile(filepath);
-        auto shaderSources = PreProcess(source);
-        Compile(shaderSources);
+        for (unsigned char c : value)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
 
+    static std::string GetDriverString()
+    {
+        auto getString = [](GLenum name) { auto value = glGetString(name); return value ? std::string((const char*)value) : std::string(); };
+        return getString(GL_VENDOR) + "|" + getString(GL_RENDERER) + "|" + getString(GL_VERSION);
+    }
+
+    OpenGLShader::OpenGLShader(const std::string& filepath, const std::string& binaryCacheDirectory)
+    {
         // Extract name from filepath
         auto lastSlash = filepath.find_last_of("/\\");
         lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
         auto lastDot = filepath.rfind('.');
         auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
         m_Name = filepath.substr(lastSlash, count);
+
+        std::string source = ReadFile(filepath);
+
+        GLint binaryFormatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+        if (binaryCacheDirectory.empty() || binaryFormatCount == 0)
+        {
+            Compile(PreProcess(source));
+            return;
+        }
+
+        std::string cachePath = binaryCacheDirectory + "/" + m_Name + ".bin";
+        uint64_t sourceHash = HashString(GetDriverString(), HashString(source));
+        if (LoadProgramBinary(cachePath, sourceHash))
+        {
+            m_IsLoadedFromCache = true;
+            return;
+        }
+
+        //a program that failed to build is not cached, the next run reports the errors again
+        if (Compile(PreProcess(source), true))
+            SaveProgramBinary(cachePath, sourceHash);
     }
 
     OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -106,10 +143,13 @@ namespace CADMageddon {
         return shaderSources;
     }
 
-    void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
+    bool OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources, bool retrievableBinary)
     {
 
         GLuint program = glCreateProgram();
+        if (retrievableBinary)
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
         auto size = shaderSources.size();
 
         std::vector<GLenum> glShaderIDs(size);
@@ -139,17 +179,24 @@ namespace CADMageddon {
 
                 glDeleteShader(shader);
 
+                //linking the stages that did compile could succeed, the broken program must not be used or cached
+                for (int i = 0; i < glShaderIDIndex; i++)
+                {
+                    glDetachShader(program, glShaderIDs[i]);
+                    glDeleteShader(glShaderIDs[i]);
+                }
+
+                glDeleteProgram(program);
+
                 LOG_ERROR("{0}", infoLog.data());
                 LOG_ERROR("Shader compilation failure!");
-                break;
+                return false;
             }
 
             glAttachShader(program, shader);
             glShaderIDs[glShaderIDIndex++] = shader;
         }
 
-        m_RendererID = program;
-
         // Link our program
         glLinkProgram(program);
 
@@ -173,7 +220,7 @@ namespace CADMageddon {
 
             LOG_ERROR("{0}", infoLog.data());
             LOG_ERROR("Shader link failure!");
-            return;
+            return false;
         }
 
         for (auto id : glShaderIDs)
@@ -181,6 +228,73 @@ namespace CADMageddon {
             glDetachShader(program, id);
             glDeleteShader(id);
         }
+
+        m_RendererID = program;
+        return true;
+    }
+
+    bool OpenGLShader::LoadProgramBinary(const std::string& cachePath, uint64_t sourceHash)
+    {
+        std::ifstream in(cachePath, std::ios::in | std::ios::binary);
+        if (!in)
+            return false;
+
+        uint64_t cachedHash = 0;
+        GLenum format = 0;
+        in.read((char*)&cachedHash, sizeof(cachedHash));
+        in.read((char*)&format, sizeof(format));
+        if (!in || cachedHash != sourceHash)
+            return false;
+
+        std::vector<char> binary((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (binary.empty())
+            return false;
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, format, binary.data(), (GLsizei)binary.size());
+
+        //the driver may reject a binary it produced itself, e.g. after an update, fall back to compiling then
+        GLint isLinked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+        if (isLinked == GL_FALSE)
+        {
+            glDeleteProgram(program);
+            return false;
+        }
+
+        m_RendererID = program;
+        return true;
+    }
+
+    void OpenGLShader::SaveProgramBinary(const std::string& cachePath, uint64_t sourceHash)
+    {
+        GLint isLinked = 0;
+        glGetProgramiv(m_RendererID, GL_LINK_STATUS, &isLinked);
+        if (isLinked == GL_FALSE)
+            return;
+
+        GLint length = 0;
+        glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length == 0)
+            return;
+
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        glGetProgramBinary(m_RendererID, length, nullptr, &format, binary.data());
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), error);
+
+        std::ofstream out(cachePath, std::ios::out | std::ios::binary);
+        if (!out)
+        {
+            LOG_ERROR("Could not write program binary '{0}'", cachePath);
+            return;
+        }
+
+        out.write((const char*)&sourceHash, sizeof(sourceHash));
+        out.write((const char*)&format, sizeof(format));
+        out.write(binary.data(), binary.size());
     }
 
     void OpenGLShader::Bind() const
@@ -208,6 +322,16 @@ namespace CADMageddon {
         UploadUniformFloat(name, value);
     }
 
+    void OpenGLShader::SetFloatArray(const std::string& name, float* values, uint32_t count)
+    {
+        UploadUniformFloatArray(name, values, count);
+    }
+
+    void OpenGLShader::SetFloat2(const std::string& name, const glm::vec2& value)
+    {
+        UploadUniformFloat2(name, value);
+    }
+
     void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
     {
         UploadUniformFloat3(name, value);
@@ -223,6 +347,11 @@ namespace CADMageddon {
         UploadUniformFloat4(name, value);
     }
 
+    void OpenGLShader::SetFloat4Array(const std::string& name, glm::vec4* values, uint32_t count)
+    {
+        UploadUniformFloat4Array(name, values, count);
+    }
+
     void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
     {
         UploadUniformMat4(name, value);
@@ -287,10 +416,22 @@ namespace CADMageddon {
         glUniform3fv(location, count, &values[0].x);
     }
 
+    void OpenGLShader::UploadUniformFloatArray(const std::string& name, float* values, uint32_t count)
+    {
+        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+        glUniform1fv(location, count, values);
+    }
+
+    void OpenGLShader::UploadUniformFloat4Array(const std::string& name, glm::vec4* values, uint32_t count)
+    {
+        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+        glUniform4fv(location, count, &values[0].x);
+    }
+
     Ref<OpenGLShader> ShaderLibrary::Load(const std::string& name, const std::string& filepath)
     {
         //TODO error checking e.g. no duplicate load
-        auto shader = CreateRef<OpenGLShader>(filepath);
+        auto shader = CreateRef<OpenGLShader>(filepath, m_BinaryCacheDirectory);
         m_Shaders.insert({ name,shader });
         return shader;
     }
@@ -10,7 +10,7 @@ namespace CADMageddon
     class OpenGLShader
     {
     public:
-        OpenGLShader(const std::string& filepath);
+        OpenGLShader(const std::string& filepath, const std::string& binaryCacheDirectory = "");
         OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
         virtual ~OpenGLShader();
 
@@ -20,32 +20,43 @@ namespace CADMageddon
         void SetInt(const std::string& name, int value);
         void SetIntArray(const std::string& name, int* values, uint32_t count);
         void SetFloat(const std::string& name, float value);
+        void SetFloatArray(const std::string& name, float* values, uint32_t count);
+        void SetFloat2(const std::string& name, const glm::vec2& value);
         void SetFloat3(const std::string& name, const glm::vec3& value);
         void SetFloat3Array(const std::string& name, glm::vec3 * values, uint32_t count);
         void SetFloat4(const std::string& name, const glm::vec4& value);
+        void SetFloat4Array(const std::string& name, glm::vec4* values, uint32_t count);
         void SetMat4(const std::string& name, const glm::mat4& value);
         void SetBool(const std::string& name, bool value);
 
         const std::string& GetName() const { return m_Name; }
+        bool GetIsLoadedFromCache() const { return m_IsLoadedFromCache; }
 
         void UploadUniformInt(const std::string& name, int value);
         void UploadUniformIntArray(const std::string& name, int* values, uint32_t count);
 
         void UploadUniformFloat(const std::string& name, float value);
+        void UploadUniformFloatArray(const std::string& name, float* values, uint32_t count);
         void UploadUniformFloat2(const std::string& name, const glm::vec2& value);
         void UploadUniformFloat3(const std::string& name, const glm::vec3& value);
         void UploadUniformFloat3Array(const std::string& name, glm::vec3* values, uint32_t count);
         void UploadUniformFloat4(const std::string& name, const glm::vec4& value);
+        void UploadUniformFloat4Array(const std::string& name, glm::vec4* values, uint32_t count);
 
         void UploadUniformMat3(const std::string& name, const glm::mat3& matrix);
         void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
     private:
         std::string ReadFile(const std::string& filepath);
         std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
-        void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
+        //returns false when a stage fails to compile or the program to link, the shader is left without a program
+        bool Compile(const std::unordered_map<GLenum, std::string>& shaderSources, bool retrievableBinary = false);
+
+        bool LoadProgramBinary(const std::string& cachePath, uint64_t sourceHash);
+        void SaveProgramBinary(const std::string& cachePath, uint64_t sourceHash);
     private:
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
         std::string m_Name;
+        bool m_IsLoadedFromCache = false;
     };
 
     class ShaderLibrary
@@ -54,7 +65,11 @@ namespace CADMageddon
         Ref<OpenGLShader> Load(const std::string& name, const std::string& filepath);
         Ref<OpenGLShader> Get(const std::string& name);
 
+        //linked programs are stored here keyed by source hash and driver, empty disables the cache
+        void SetBinaryCacheDirectory(const std::string& directory) { m_BinaryCacheDirectory = directory; }
+
     private:
         std::unordered_map<std::string, Ref<OpenGLShader>> m_Shaders;
+        std::string m_BinaryCacheDirectory;
     };
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace CADMageddon
         case ShaderDataType::Int2:     return GL_INT;
         case ShaderDataType::Int3:     return GL_INT;
         case ShaderDataType::Int4:     return GL_INT;
+        case ShaderDataType::UByte:    return GL_UNSIGNED_BYTE;
         case ShaderDataType::Bool:     return GL_BOOL;
         }
 
@@ -46,7 +47,7 @@ namespace CADMageddon
         glBindVertexArray(0);
     }
 
-    void OpenGLVertexArray::AddVertexBuffer(const Ref<OpenGLVertexBuffer>& vertexBuffer)
+    void OpenGLVertexArray::AddVertexBuffer(const Ref<OpenGLVertexBuffer>& vertexBuffer, uint32_t divisor)
     {
 
         glBindVertexArray(m_RendererID);
@@ -61,19 +62,33 @@ namespace CADMageddon
                 case ShaderDataType::Float2:
                 case ShaderDataType::Float3:
                 case ShaderDataType::Float4:
+                case ShaderDataType::Bool:
+                {
+                    glEnableVertexAttribArray(m_VertexBufferIndex);
+                    glVertexAttribPointer(m_VertexBufferIndex,
+                        element.GetComponentCount(),
+                        ShaderDataTypeToOpenGLBaseType(element.Type),
+                        element.Normalized ? GL_TRUE : GL_FALSE,
+                        layout.GetStride(),
+                        (const void*)element.Offset);
+                    glVertexAttribDivisor(m_VertexBufferIndex, divisor);
+                    m_VertexBufferIndex++;
+                    break;
+                }
                 case ShaderDataType::Int:
                 case ShaderDataType::Int2:
                 case ShaderDataType::Int3:
                 case ShaderDataType::Int4:
-                case ShaderDataType::Bool:
+                case ShaderDataType::UByte:
                 {
+                    //integer attributes have to stay integers in the shader, e.g. picking ids
                     glEnableVertexAttribArray(m_VertexBufferIndex);
-                    glVertexAttribPointer(m_VertexBufferIndex,
+                    glVertexAttribIPointer(m_VertexBufferIndex,
                         element.GetComponentCount(),
                         ShaderDataTypeToOpenGLBaseType(element.Type),
-                        element.Normalized ? GL_TRUE : GL_FALSE,
                         layout.GetStride(),
                         (const void*)element.Offset);
+                    glVertexAttribDivisor(m_VertexBufferIndex, divisor);
                     m_VertexBufferIndex++;
                     break;
                 }
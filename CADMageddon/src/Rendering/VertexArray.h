@@ -13,7 +13,8 @@ namespace CADMageddon
         void Bind() const;
         void UnBind() const;
 
-        void AddVertexBuffer(const Ref<OpenGLVertexBuffer>& vertexBuffer);
+        //a divisor of 1 advances the attributes once per instance instead of once per vertex
+        void AddVertexBuffer(const Ref<OpenGLVertexBuffer>& vertexBuffer, uint32_t divisor = 0);
         void SetIndexBuffer(const Ref<OpenGLIndexBuffer>& indexBuffer);
 
         const std::vector<Ref<OpenGLVertexBuffer>>& GetVertexBuffers() const
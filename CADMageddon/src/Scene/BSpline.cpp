@@ -5,40 +5,47 @@ namespace CADMageddon
     void BSpline::SetShowPoints(bool setShowPoints)
     {
         m_ShowPoints = setShowPoints;
-        for (auto point : m_ControlPoints)
+        SetControlPointsVisible(setShowPoints);
+    }
+
+    const std::vector<glm::vec3>& BSpline::GetBezierControlPoints()
+    {
+        if (m_BezierControlPointsRevision != m_Revision)
         {
-            point->SetIsVisible(setShowPoints);
+            CalculateBezierControlPoints();
+            m_BezierControlPointsRevision = m_Revision;
         }
+
+        return m_BezierControlPoints;
     }
 
-    std::vector<glm::vec3> BSpline::GetBezierControlPoints() const
+    void BSpline::CalculateBezierControlPoints()
     {
-     
+        m_BezierControlPoints.clear();
         if (m_SnapToEnd && m_ControlPoints.empty())
         {
-            return std::vector<glm::vec3>();
+            return;
         }
         else if (!m_SnapToEnd && m_ControlPoints.size() < 4)
         {
-            return std::vector<glm::vec3>();
+            return;
         }
 
         std::vector<glm::vec3> deBoors;
         if (m_SnapToEnd)
         {
-            deBoors.push_back(m_ControlPoints.front()->GetPosition());
-            deBoors.push_back(m_ControlPoints.front()->GetPosition());
+            deBoors.push_back(GetControlPointPosition(0));
+            deBoors.push_back(GetControlPointPosition(0));
         }
 
-        std::transform(m_ControlPoints.begin(), m_ControlPoints.end(), std::back_inserter(deBoors), [](Ref<Point> x) {return x->GetPosition(); });
+        std::transform(m_ControlPoints.begin(), m_ControlPoints.end(), std::back_inserter(deBoors), [](PointHandle x) {return PointStore::Get().GetPosition(x); });
 
         if (m_SnapToEnd)
         {
-            deBoors.push_back(m_ControlPoints.back()->GetPosition());
-            deBoors.push_back(m_ControlPoints.back()->GetPosition());
+            deBoors.push_back(GetControlPointPosition(m_ControlPoints.size() - 1));
+            deBoors.push_back(GetControlPointPosition(m_ControlPoints.size() - 1));
         }
 
-        std::vector<glm::vec3> bezierCoords;
         std::vector<glm::vec3> midPoints;
 
         for (int i = 1; i < deBoors.size(); i++) {
@@ -47,11 +54,9 @@ namespace CADMageddon
         }
         for (int i = 1; i < midPoints.size() - 2; i++) {
             if (i > 1)
-                bezierCoords.emplace_back(midPoints[i]);
+                m_BezierControlPoints.emplace_back(midPoints[i]);
             if (i % 2 == 1)
-                bezierCoords.emplace_back((midPoints[i] + midPoints[i + 1]) / 2.f);
+                m_BezierControlPoints.emplace_back((midPoints[i] + midPoints[i + 1]) / 2.f);
         }
-
-        return bezierCoords;
     }
 }
\ No newline at end of file
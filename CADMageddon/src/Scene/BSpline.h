@@ -10,7 +10,8 @@ namespace CADMageddon
     public:
         BSpline(std::string name) :Curve(name) {}
 
-        std::vector<glm::vec3> GetBezierControlPoints() const;
+        //rebuilt only after the curve was invalidated
+        const std::vector<glm::vec3>& GetBezierControlPoints();
 
         bool GetShowBSplinePolygon() const { return m_ShowBSplinePolygon; }
         void SetShowBSplinePolygon(bool showPolygon) { m_ShowBSplinePolygon = showPolygon; }
@@ -25,7 +26,14 @@ namespace CADMageddon
         void SetShowPoints(bool setShowPoints);
 
         bool GetSnapToEnd() const { return m_SnapToEnd; }
-        void SetSnapToEnd(bool snap) { m_SnapToEnd = snap; }
+        void SetSnapToEnd(bool snap)
+        {
+            m_SnapToEnd = snap;
+            Invalidate();
+        }
+
+    private:
+        void CalculateBezierControlPoints();
 
     private:
         bool m_ShowPoints = true;
@@ -34,5 +42,8 @@ namespace CADMageddon
         bool m_IsBezierBasis = false;
 
         bool m_SnapToEnd = false;
+
+        std::vector<glm::vec3> m_BezierControlPoints;
+        uint64_t m_BezierControlPointsRevision = 0;
     };
 }
\ No newline at end of file
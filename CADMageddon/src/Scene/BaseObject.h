@@ -1,6 +1,8 @@
 #pragma once
 #include "Point.h"
 #include "cadpch.h"
+#include "Rendering\BoundingBox.h"
+#include "SceneEntity.h"
 
 namespace CADMageddon
 {
@@ -9,10 +11,35 @@ namespace CADMageddon
     public:
         
         BaseObject(const std::string& name) : m_Name(name) {}
+        virtual ~BaseObject() = default;
+
+        std::vector<PointHandle>& GetControlPoints() { return m_ControlPoints; }
+        const std::vector<PointHandle>& GetControlPoints() const { return m_ControlPoints; }
+        glm::vec3 GetControlPointPosition(size_t index) const { return PointStore::Get().GetPosition(m_ControlPoints[index]); }
+
+        //adds a new point to the object, the object keeps it alive until a scene takes it with TakeCreatedPoints
+        PointHandle CreateControlPoint(const glm::vec3& position, const std::string& name)
+        {
+            auto point = CreateRef<Point>(position, name);
+            m_CreatedPoints.push_back(point);
+            m_ControlPoints.push_back(point->GetHandle());
+            Invalidate();
+            return point->GetHandle();
+        }
+
+        std::vector<Ref<Point>> TakeCreatedPoints()
+        {
+            std::vector<Ref<Point>> points;
+            points.swap(m_CreatedPoints);
+            return points;
+        }
 
-        std::vector<Ref<Point>>& GetControlPoints() { return m_ControlPoints; }
         bool GetIsSelected() const { return m_IsSelected; }
-        void SetIsSelected(bool isSelected) { m_IsSelected = isSelected; }
+        void SetIsSelected(bool isSelected)
+        {
+            m_IsSelected = isSelected;
+            m_Entity.SetTag<SelectedComponent>(isSelected);
+        }
 
         std::string GetName() const { return m_Name; }
         void SetName(std::string name) { m_Name = name; }
@@ -21,14 +48,60 @@ namespace CADMageddon
         void SetIsVisible(bool isVisible)
         {
             m_isVisible = isVisible;
+            m_Entity.SetTag<VisibleComponent>(isVisible);
+            SetControlPointsVisible(isVisible);
+        }
+
+        SceneEntity& GetEntity() { return m_Entity; }
+
+        //grows whenever something the object is built from changes, cached derived data remembers the revision it was built for
+        uint64_t GetRevision() const { return m_Revision; }
+        void Invalidate() { m_Revision++; }
+
+        virtual const BoundingBox& GetBoundingBox()
+        {
+            if (m_BoundingBoxRevision != m_Revision)
+            {
+                RecalculateBoundingBox();
+                m_BoundingBoxRevision = m_Revision;
+            }
+
+            return m_BoundingBox;
+        }
+
+    protected:
+        void SetControlPointsVisible(bool isVisible)
+        {
+            for (auto handle : m_ControlPoints)
+            {
+                if (auto point = PointStore::Get().GetPoint(handle))
+                    point->SetIsVisible(isVisible);
+            }
+        }
+
+        //world space box of everything the object renders, surfaces and curves lie inside the hull of their control points
+        virtual void RecalculateBoundingBox()
+        {
+            m_BoundingBox.Reset();
             for (auto point : m_ControlPoints)
-                point->SetIsVisible(isVisible);
+                m_BoundingBox.Expand(PointStore::Get().GetPosition(point));
         }
 
     protected:
         bool m_isVisible = true;
-        std::vector<Ref<Point>> m_ControlPoints;
+        //the points live in the scene, the object only refers to them
+        std::vector<PointHandle> m_ControlPoints;
+        //points the object made itself and no scene has taken yet
+        std::vector<Ref<Point>> m_CreatedPoints;
         bool m_IsSelected = false;
         std::string m_Name;
+
+        //the scene bumps the revision when a control point moves, see Scene::PropagateChanges
+        uint64_t m_Revision = 1;
+
+        BoundingBox m_BoundingBox;
+        uint64_t m_BoundingBoxRevision = 0;
+
+        SceneEntity m_Entity;
     };
 }
\ No newline at end of file
@@ -5,9 +5,6 @@ namespace CADMageddon
     void BezierC0::SetShowPoints(bool setShowPoints)
     {
         m_ShowPoints = setShowPoints;
-        for (auto point : m_ControlPoints)
-        {
-            point->SetIsVisible(setShowPoints);
-        }
+        SetControlPointsVisible(setShowPoints);
     }
 }
\ No newline at end of file
@@ -7,12 +7,16 @@ namespace CADMageddon
     {
     }
 
-    std::vector<glm::vec3> BezierPatch::GetRenderingVertices() const
+    const std::vector<glm::vec3>& BezierPatch::GetRenderingVertices()
     {
+        if (m_RenderingVerticesRevision == m_Revision)
+            return m_RenderingVertices;
+
         int rowCount = m_PatchCountY * 3 + 1;
         int verticesColumnCount = m_IsCylinder ? m_PatchCountX * 3 : m_PatchCountX * 3 + 1;
         int columnCount = m_PatchCountX * 3 + 1;
-        std::vector<glm::vec3> vertices(rowCount * columnCount);
+        auto& vertices = m_RenderingVertices;
+        vertices.resize(rowCount * columnCount);
 
         for (int i = 0; i < rowCount; i++)
         {
@@ -27,25 +31,23 @@ namespace CADMageddon
                     controlPointsIndex -= verticesColumnCount;
                 }
 
-                vertices[index] = m_ControlPoints[controlPointsIndex]->GetPosition();
+                vertices[index] = GetControlPointPosition(controlPointsIndex);
             }
         }
 
+        m_RenderingVerticesRevision = m_Revision;
         return vertices;
     }
 
     void BezierPatch::SetShowPoints(bool setShowPoints)
     {
         m_ShowPoints = setShowPoints;
-        for (auto point : m_ControlPoints)
-        {
-            point->SetIsVisible(setShowPoints);
-        }
+        SetControlPointsVisible(setShowPoints);
     }
 
     Ref<BezierPatch> BezierPatch::CreateBezierPatch(
         std::string name,
-        std::vector<Ref<Point>> controlPoints,
+        std::vector<PointHandle> controlPoints,
         int rowCount,
         int columnCount,
         int uDivisionCount,
@@ -100,9 +102,7 @@ namespace CADMageddon
                 float v = i * deltaHeight;
 
                 glm::vec3 position = startPosition + glm::vec3(u, 0.0f, 0.0f) + glm::vec3(0.0f, v, 0.0f);
-                auto point = CreateRef<Point>(position, m_Name + "Point_" + std::to_string(pointCount++));
-                point->SetReferencedCount(1);
-                m_ControlPoints.push_back(point);
+                CreateControlPoint(position, m_Name + "Point_" + std::to_string(pointCount++));
             }
         }
     }
@@ -191,9 +191,7 @@ namespace CADMageddon
                 position.x += radius * cos(u);
                 position.z += radius * sin(u);
                 position.y += v;
-                auto point = CreateRef<Point>(position, m_Name + "Point_" + std::to_string(pointCount++));
-                point->SetReferencedCount(1);
-                m_ControlPoints.push_back(point);
+                CreateControlPoint(position, m_Name + "Point_" + std::to_string(pointCount++));
             }
         }
     }
@@ -298,25 +296,25 @@ namespace CADMageddon
         auto basisU = BernsteinBasis(u);
         auto basisV = BernsteinBasis(v);
 
-        point = basisU.x * (basisV.x * m_ControlPoints[patchIndices[0]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[4]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[8]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[12]]->GetPosition());
+        point = basisU.x * (basisV.x * GetControlPointPosition(patchIndices[0])
+            + basisV.y * GetControlPointPosition(patchIndices[4])
+            + basisV.z * GetControlPointPosition(patchIndices[8])
+            + basisV.w * GetControlPointPosition(patchIndices[12]));
 
-        point += basisU.y * (basisV.x * m_ControlPoints[patchIndices[1]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[5]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[9]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[13]]->GetPosition());
+        point += basisU.y * (basisV.x * GetControlPointPosition(patchIndices[1])
+            + basisV.y * GetControlPointPosition(patchIndices[5])
+            + basisV.z * GetControlPointPosition(patchIndices[9])
+            + basisV.w * GetControlPointPosition(patchIndices[13]));
 
-        point += basisU.z * (basisV.x * m_ControlPoints[patchIndices[2]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[6]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[10]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[14]]->GetPosition());
+        point += basisU.z * (basisV.x * GetControlPointPosition(patchIndices[2])
+            + basisV.y * GetControlPointPosition(patchIndices[6])
+            + basisV.z * GetControlPointPosition(patchIndices[10])
+            + basisV.w * GetControlPointPosition(patchIndices[14]));
 
-        point += basisU.w * (basisV.x * m_ControlPoints[patchIndices[3]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[7]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[11]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[15]]->GetPosition());
+        point += basisU.w * (basisV.x * GetControlPointPosition(patchIndices[3])
+            + basisV.y * GetControlPointPosition(patchIndices[7])
+            + basisV.z * GetControlPointPosition(patchIndices[11])
+            + basisV.w * GetControlPointPosition(patchIndices[15]));
 
         return point;
     }
@@ -337,25 +335,25 @@ namespace CADMageddon
         auto basisU = dBernsteinBasis(u);
         auto basisV = BernsteinBasis(v);
 
-        point = basisU.x * (basisV.x * m_ControlPoints[patchIndices[0]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[4]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[8]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[12]]->GetPosition());
+        point = basisU.x * (basisV.x * GetControlPointPosition(patchIndices[0])
+            + basisV.y * GetControlPointPosition(patchIndices[4])
+            + basisV.z * GetControlPointPosition(patchIndices[8])
+            + basisV.w * GetControlPointPosition(patchIndices[12]));
 
-        point += basisU.y * (basisV.x * m_ControlPoints[patchIndices[1]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[5]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[9]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[13]]->GetPosition());
+        point += basisU.y * (basisV.x * GetControlPointPosition(patchIndices[1])
+            + basisV.y * GetControlPointPosition(patchIndices[5])
+            + basisV.z * GetControlPointPosition(patchIndices[9])
+            + basisV.w * GetControlPointPosition(patchIndices[13]));
 
-        point += basisU.z * (basisV.x * m_ControlPoints[patchIndices[2]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[6]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[10]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[14]]->GetPosition());
+        point += basisU.z * (basisV.x * GetControlPointPosition(patchIndices[2])
+            + basisV.y * GetControlPointPosition(patchIndices[6])
+            + basisV.z * GetControlPointPosition(patchIndices[10])
+            + basisV.w * GetControlPointPosition(patchIndices[14]));
 
-        point += basisU.w * (basisV.x * m_ControlPoints[patchIndices[3]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[7]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[11]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[15]]->GetPosition());
+        point += basisU.w * (basisV.x * GetControlPointPosition(patchIndices[3])
+            + basisV.y * GetControlPointPosition(patchIndices[7])
+            + basisV.z * GetControlPointPosition(patchIndices[11])
+            + basisV.w * GetControlPointPosition(patchIndices[15]));
 
         return point * float(m_PatchCountX);
     }
@@ -376,25 +374,25 @@ namespace CADMageddon
         auto basisU = BernsteinBasis(u);
         auto basisV = dBernsteinBasis(v);
 
-        point = basisU.x * (basisV.x * m_ControlPoints[patchIndices[0]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[4]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[8]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[12]]->GetPosition());
-
-        point += basisU.y * (basisV.x * m_ControlPoints[patchIndices[1]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[5]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[9]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[13]]->GetPosition());
-
-        point += basisU.z * (basisV.x * m_ControlPoints[patchIndices[2]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[6]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[10]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[14]]->GetPosition());
-
-        point += basisU.w * (basisV.x * m_ControlPoints[patchIndices[3]]->GetPosition()
-            + basisV.y * m_ControlPoints[patchIndices[7]]->GetPosition()
-            + basisV.z * m_ControlPoints[patchIndices[11]]->GetPosition()
-            + basisV.w * m_ControlPoints[patchIndices[15]]->GetPosition());
+        point = basisU.x * (basisV.x * GetControlPointPosition(patchIndices[0])
+            + basisV.y * GetControlPointPosition(patchIndices[4])
+            + basisV.z * GetControlPointPosition(patchIndices[8])
+            + basisV.w * GetControlPointPosition(patchIndices[12]));
+
+        point += basisU.y * (basisV.x * GetControlPointPosition(patchIndices[1])
+            + basisV.y * GetControlPointPosition(patchIndices[5])
+            + basisV.z * GetControlPointPosition(patchIndices[9])
+            + basisV.w * GetControlPointPosition(patchIndices[13]));
+
+        point += basisU.z * (basisV.x * GetControlPointPosition(patchIndices[2])
+            + basisV.y * GetControlPointPosition(patchIndices[6])
+            + basisV.z * GetControlPointPosition(patchIndices[10])
+            + basisV.w * GetControlPointPosition(patchIndices[14]));
+
+        point += basisU.w * (basisV.x * GetControlPointPosition(patchIndices[3])
+            + basisV.y * GetControlPointPosition(patchIndices[7])
+            + basisV.z * GetControlPointPosition(patchIndices[11])
+            + basisV.w * GetControlPointPosition(patchIndices[15]));
 
         return point * float(m_PatchCountY);
     }
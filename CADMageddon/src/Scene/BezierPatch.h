@@ -12,10 +12,11 @@ namespace CADMageddon
     public:
         BezierPatch(std::string name, int patchCountX, int patchCountY, int uDivisionCount = 4, int vDivisionCount = 4);
 
-        std::vector<uint32_t> GetRenderingIndices() const { return m_Indices; }
-        std::vector<uint32_t> GetGridIndices() const { return m_GridIndices; }
-        std::vector<glm::vec2> GetTextureCoordinates() const { return m_TextureCooridnates; }
-        std::vector<glm::vec3> GetRenderingVertices() const;
+        const std::vector<uint32_t>& GetRenderingIndices() const { return m_Indices; }
+        const std::vector<uint32_t>& GetGridIndices() const { return m_GridIndices; }
+        const std::vector<glm::vec2>& GetTextureCoordinates() const { return m_TextureCooridnates; }
+        //rebuilt only after the patch was invalidated
+        const std::vector<glm::vec3>& GetRenderingVertices();
 
         bool GetShowPolygon() const { return m_ShowPolygon; }
         void SetShowPolygon(bool showPolygon) { m_ShowPolygon = showPolygon; }
@@ -57,7 +58,7 @@ namespace CADMageddon
         //used for deserialization
         static Ref<BezierPatch> BezierPatch::CreateBezierPatch(
             std::string name,
-            std::vector<Ref<Point>> controlPoints,
+            std::vector<PointHandle> controlPoints,
             int rowCount,
             int columnCount,
             int uDivisionCount,
@@ -101,5 +102,8 @@ namespace CADMageddon
         std::vector<uint32_t> m_Indices;
         std::vector<uint32_t> m_GridIndices;
         std::vector<glm::vec2> m_TextureCooridnates;
+
+        std::vector<glm::vec3> m_RenderingVertices;
+        uint64_t m_RenderingVerticesRevision = 0;
     };
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include "cadpch.h"
+#include "Core\Base.h"
+#include "PointStore.h"
+
+namespace CADMageddon
+{
+    class BaseObject;
+
+    // Components of the scene registry entities. The objects still own their data,
+    // the components point at it so the scene walks one packed pool per concern.
+
+    //the object behind the entity, every object type has its own pool
+    template<typename T>
+    struct ObjectComponent
+    {
+        Ref<T> Object;
+    };
+
+    //objects built from points, owned by the object and only referenced here
+    struct ControlPointRefsComponent
+    {
+        std::vector<PointHandle>* Points = nullptr;
+    };
+
+    //objects caching data derived from what they are built from, invalidated by Scene::PropagateChanges
+    struct DerivedDataComponent
+    {
+        BaseObject* Object = nullptr;
+    };
+
+    //tags mirrored from the objects' flags by SceneEntity
+    struct SelectedComponent {};
+    struct VisibleComponent {};
+
+    //set on the victims of a batch delete until they leave their containers
+    struct DeletedComponent {};
+}
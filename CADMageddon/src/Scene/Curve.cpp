@@ -2,23 +2,17 @@
 
 namespace CADMageddon
 {
-    void Curve::AddControlPoint(Ref<Point> point)
+    void Curve::AddControlPoint(PointHandle point)
     {
-        int referenceCount = point->GetReferencedCount();
-        point->SetReferencedCount(referenceCount + 1);
         m_ControlPoints.push_back(point);
+        Invalidate();
     }
 
-    void Curve::RemoveControlPoint(Ref<Point> controlPoint)
+    void Curve::RemoveControlPoint(PointHandle controlPoint)
     {
-        auto it = std::find(m_ControlPoints.begin(), m_ControlPoints.end(), controlPoint);
-        while (it != m_ControlPoints.end())
-        {
-            m_ControlPoints.erase(it);
-            it = std::find(m_ControlPoints.begin(), m_ControlPoints.end(), controlPoint);
-        }
+        //a point can repeat in the curve, every occurrence goes in one pass
+        m_ControlPoints.erase(std::remove(m_ControlPoints.begin(), m_ControlPoints.end(), controlPoint), m_ControlPoints.end());
 
-        int referenceCount = controlPoint->GetReferencedCount() - 1;
-        controlPoint->SetReferencedCount(referenceCount);
+        Invalidate();
     }
 }
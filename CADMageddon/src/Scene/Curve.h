@@ -7,7 +7,7 @@ namespace CADMageddon
     {
     public:
         Curve(std::string name) :BaseObject(name) {}
-        void AddControlPoint(Ref<Point> point);
-        void RemoveControlPoint(Ref<Point> point);
+        void AddControlPoint(PointHandle point);
+        void RemoveControlPoint(PointHandle point);
     };
 }
\ No newline at end of file
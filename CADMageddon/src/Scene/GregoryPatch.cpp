@@ -2,6 +2,47 @@
 
 namespace CADMageddon
 {
+    //de Casteljau on fixed size curves, the copies stay on the stack
+    template<size_t N>
+    static std::array<glm::vec3, N> GetSecondHalfBezier(std::array<glm::vec3, N> curve)
+    {
+        for (int i = (int)N - 1; i > 0; i--)
+            for (int j = 0; j < i; j++)
+                curve[j] = (curve[j] + curve[j + 1]) / 2.0f;
+
+        return curve;
+    }
+
+    template<size_t N>
+    static std::array<glm::vec3, N> GetFirstHalfBezier(std::array<glm::vec3, N> curve)
+    {
+        for (int i = 0; i < (int)N - 1; i++)
+            for (int j = (int)N - 1; j > i; j--)
+                curve[j] = (curve[j] + curve[j - 1]) / 2.0f;
+
+        return curve;
+    }
+
+    template<size_t N>
+    static glm::vec3 BezierValue(std::array<glm::vec3, N> curve, float t)
+    {
+        for (int i = (int)N - 1; i > 0; i--)
+            for (int j = 0; j < i; j++)
+                curve[j] = (curve[j] + curve[j + 1]) / 2.0f;
+
+        return curve[0];
+    }
+
+    template<size_t N>
+    static glm::vec3 BezierFirstDerivativeValue(std::array<glm::vec3, N> curve, float t)
+    {
+        for (int i = (int)N - 1; i > 1; i--)
+            for (int j = 0; j < i; j++)
+                curve[j] = (curve[j] + curve[j + 1]) / 2.0f;
+
+        return 3.0f * (curve[1] - curve[0]);
+    }
+
     GregoryPatch::GregoryPatch(std::string name, Border border[3])
         : BaseObject(name)
     {
@@ -14,7 +55,7 @@ namespace CADMageddon
         Ref<BezierPatch> b1,
         Ref<BezierPatch> b2,
         Ref<BezierPatch> b3,
-        Ref<Point> commonPoints[3])
+        PointHandle commonPoints[3])
     {
         static int gregoryCount = 0;
         Border border[3] =
@@ -31,45 +72,22 @@ namespace CADMageddon
         return gregory;
     }
 
-    std::vector<glm::vec3> GregoryPatch::GetSecondHalfBezier(std::vector<glm::vec3> curve)
-    {
-        for (int i = curve.size() - 1; i > 0; i--)
-            for (int j = 0; j < i; j++)
-                curve[j] = (curve[j] + curve[j + 1]) / 2.0f;
-
-        return curve;
-    }
-
-    std::vector<glm::vec3> GregoryPatch::GetFirstHalfBezier(std::vector<glm::vec3> curve)
+    void GregoryPatch::RecalculateBoundingBox()
     {
-        for (int i = 0; i < curve.size() - 1; i++)
-            for (int j = curve.size() - 1; j > i; j--)
-                curve[j] = (curve[j] + curve[j - 1]) / 2.0f;
-
-        return curve;
-    }
-
-    glm::vec3 GregoryPatch::BezierValue(std::vector<glm::vec3> curve, float t)
-    {
-        for (int i = curve.size() - 1; i > 0; i--)
-            for (int j = 0; j < i; j++)
-                curve[j] = (curve[j] + curve[j + 1]) / 2.0f;
+        m_BoundingBox.Reset();
 
-        return curve[0];
-    }
-
-    glm::vec3 GregoryPatch::BezierFirstDerivativeValue(std::vector<glm::vec3> curve, float t)
-    {
-        for (int i = curve.size() - 1; i > 1; i--)
-            for (int j = 0; j < i; j++)
-                curve[j] = (curve[j] + curve[j + 1]) / 2.0f;
-
-        return 3.0f * (curve[1] - curve[0]);
+        for (auto fill : { Fill::B12, Fill::B23, Fill::B31 })
+        {
+            const auto& gregoryPoints = GetFillingData(fill).gregoryPoints;
+            auto points = reinterpret_cast<const glm::vec3*>(&gregoryPoints);
+            for (int i = 0; i < sizeof(GregoryPoints) / sizeof(glm::vec3); i++)
+                m_BoundingBox.Expand(points[i]);
+        }
     }
 
-    Border GregoryPatch::GetBorderEnum(Ref<BezierPatch> b1, Ref<Point> p0, Ref<Point> p1)
+    Border GregoryPatch::GetBorderEnum(const Ref<BezierPatch>& b1, PointHandle p0, PointHandle p1)
     {
-        auto controlPoints = b1->GetControlPoints();
+        const auto& controlPoints = b1->GetControlPoints();
         if (p0 == controlPoints[0])
         {
             if (p1 == controlPoints[3])
@@ -102,56 +120,46 @@ namespace CADMageddon
         return Border::None;
     }
 
-    std::vector<glm::vec3> GregoryPatch::GetBorderPoints(Ref<BezierPatch> b, Border border)
+    BorderPoints GregoryPatch::GetBorderPoints(const Ref<BezierPatch>& b, Border border)
     {
-        std::vector<int> pointIndices;
-        switch (border) {
-            case Border::B30:
-                pointIndices = { 3, 2, 1, 0, 7, 6, 5, 4 };
-                break;
-            case Border::B012:
-                pointIndices = { 0, 4, 8, 12, 1, 5, 9, 13 };
-                break;
-            case Border::B1215:
-                pointIndices = { 12, 13, 14, 15, 8, 9, 10, 11 };
-                break;
-            case Border::B153:
-                pointIndices = { 15, 11, 7, 3, 14, 10, 6, 2 };
-                break;
-            case Border::B03:
-                pointIndices = { 0, 1, 2, 3, 4, 5, 6, 7 };
-                break;
-            case Border::B120:
-                pointIndices = { 12, 8, 4, 0, 13, 9, 5, 1 };
-                break;
-            case Border::B1512:
-                pointIndices = { 15, 14, 13, 12, 11, 10, 9, 8 };
-                break;
-            case Border::B315:
-                pointIndices = { 3, 7, 11, 15, 2, 6, 10, 14 };
-                break;
-        }
+        //control point indices of the inner row followed by the outer row, in Border order
+        static const int s_PointIndices[8][8] =
+        {
+            { 3, 2, 1, 0, 7, 6, 5, 4 },
+            { 0, 4, 8, 12, 1, 5, 9, 13 },
+            { 12, 13, 14, 15, 8, 9, 10, 11 },
+            { 15, 11, 7, 3, 14, 10, 6, 2 },
+            { 0, 1, 2, 3, 4, 5, 6, 7 },
+            { 12, 8, 4, 0, 13, 9, 5, 1 },
+            { 15, 14, 13, 12, 11, 10, 9, 8 },
+            { 3, 7, 11, 15, 2, 6, 10, 14 }
+        };
+
+        BorderPoints result = {};
+        if (border == Border::None)
+            return result;
 
-        auto controlPoints = b->GetControlPoints();
+        const int* pointIndices = s_PointIndices[(int)border];
+        for (int i = 0; i < 4; i++)
+        {
+            result.Inner[i] = b->GetControlPointPosition(pointIndices[i]);
+            result.Outer[i] = b->GetControlPointPosition(pointIndices[i + 4]);
+        }
 
-        auto result = std::vector<glm::vec3>(pointIndices.size());
-        for (int i = 0; i < pointIndices.size(); i++)
-            result[i] = controlPoints[pointIndices[i]]->GetPosition();
         return result;
     }
 
-    FillingData GregoryPatch::GetFillingData(
-        std::vector<glm::vec3> border,
-        std::vector<glm::vec3> borderLeft,
-        BoundaryCurve boundaryCurve,
-        BoundaryCurve boundaryCurveLeft,
-        BoundaryCurve boundaryCurveRight,
-        bool showMesh) const
+    FillingData GregoryPatch::CalculateFillingData(
+        const BorderPoints& border,
+        const BorderPoints& borderLeft,
+        const BoundaryCurve& boundaryCurve,
+        const BoundaryCurve& boundaryCurveLeft,
+        const BoundaryCurve& boundaryCurveRight)
     {
-        auto innerBorder = std::vector(border.begin(), border.begin() + 4);
-        auto innerBorderLeft = std::vector(borderLeft.begin(), borderLeft.begin() + 4);
-        auto outerBorder = std::vector(border.begin() + 4, border.end());
-        auto outerBorderLeft = std::vector(borderLeft.begin() + 4, borderLeft.end());
+        const auto& innerBorder = border.Inner;
+        const auto& innerBorderLeft = borderLeft.Inner;
+        const auto& outerBorder = border.Outer;
+        const auto& outerBorderLeft = borderLeft.Outer;
 
         glm::vec3 a0, a3, b0, b3;
 
@@ -199,8 +207,8 @@ namespace CADMageddon
         gregoryB1B2.f0_p = 2.0f * secondHalfBezierInnerP2P0[2] - secondHalfBezierOuterP2P0[2];
         gregoryB1B2.f1_m = 2.0f * secondHalfBezierInnerP2P0[1] - secondHalfBezierOuterP2P0[1];
         gregoryB1B2.f1_p = boundaryCurve.Second + dField.d1;
-        gregoryB1B2.f2_m = boundaryCurve.Third + BezierValue({ gField.g0,gField.g1,gField.g2 }, 2.0 / 3.0f);
-        gregoryB1B2.f2_p = boundaryCurveLeft.Third + BezierValue({ gFieldLeft.g0,gFieldLeft.g1,gFieldLeft.g2 }, 2.0 / 3.0f);
+        gregoryB1B2.f2_m = boundaryCurve.Third + BezierValue<3>({ gField.g0,gField.g1,gField.g2 }, 2.0 / 3.0f);
+        gregoryB1B2.f2_p = boundaryCurveLeft.Third + BezierValue<3>({ gFieldLeft.g0,gFieldLeft.g1,gFieldLeft.g2 }, 2.0 / 3.0f);
         gregoryB1B2.f3_m = boundaryCurveLeft.Second + dFieldLeft.d1;
         gregoryB1B2.f3_p = 2.0f * firstHalfBezierInnerP0P1[2] - firstHalfBezierOuterP0P1[2];
         gregoryB1B2.f0_m = 2.0f * firstHalfBezierInnerP0P1[1] - firstHalfBezierOuterP0P1[1];
@@ -221,26 +229,21 @@ namespace CADMageddon
         fillingData.gFieldVectorsLeft = gFieldLeft;
         fillingData.dFieldVectorsLeft = dFieldLeft;
 
-        fillingData.ShowMesh = showMesh;
-
         return fillingData;
     }
 
-    BoundaryCurves GregoryPatch::GetBoundaryCurvePoints() const
+    BoundaryCurves GregoryPatch::GetBoundaryCurvePoints(const BorderPoints borders[3])
     {
         BoundaryCurves boundaryPoints;
-        auto b1Border = GetBorderPoints(b1, m_Border[0]);
-        auto b2Border = GetBorderPoints(b2, m_Border[1]);
-        auto b3Border = GetBorderPoints(b3, m_Border[2]);
 
-        auto secondHalfBezierInnerP2P0 = GetSecondHalfBezier(std::vector(b1Border.begin(), b1Border.begin() + 4));
-        auto secondHalfBezierOuterP2P0 = GetSecondHalfBezier(std::vector(b1Border.begin() + 4, b1Border.end()));
+        auto secondHalfBezierInnerP2P0 = GetSecondHalfBezier(borders[0].Inner);
+        auto secondHalfBezierOuterP2P0 = GetSecondHalfBezier(borders[0].Outer);
 
-        auto secondHalfBezierInnerP0P1 = GetSecondHalfBezier(std::vector(b2Border.begin(), b2Border.begin() + 4));
-        auto secondHalfBezierOuterP0P1 = GetSecondHalfBezier(std::vector(b2Border.begin() + 4, b2Border.end()));
+        auto secondHalfBezierInnerP0P1 = GetSecondHalfBezier(borders[1].Inner);
+        auto secondHalfBezierOuterP0P1 = GetSecondHalfBezier(borders[1].Outer);
 
-        auto secondHalfBezierInnerP1P2 = GetSecondHalfBezier(std::vector(b3Border.begin(), b3Border.begin() + 4));
-        auto secondHalfBezierOuterP1P2 = GetSecondHalfBezier(std::vector(b3Border.begin() + 4, b3Border.end()));
+        auto secondHalfBezierInnerP1P2 = GetSecondHalfBezier(borders[2].Inner);
+        auto secondHalfBezierOuterP1P2 = GetSecondHalfBezier(borders[2].Outer);
 
         BoundaryCurve p1;
         BoundaryCurve p2;
@@ -282,7 +285,7 @@ namespace CADMageddon
     {
         CFieldVectors cField;
         cField.C0 = curve.Bottom;
-        cField.C05 = BezierValue({ curve.Bottom,curve.Second,curve.Third,curve.Fourth }, 0.5f);
+        cField.C05 = BezierValue<4>({ curve.Bottom,curve.Second,curve.Third,curve.Fourth }, 0.5f);
         cField.C1 = curve.Fourth;
         cField.c0 = curve.Second - curve.Bottom;
         cField.c1 = curve.Third - curve.Second;
@@ -317,8 +320,8 @@ namespace CADMageddon
         const float twoThree = 2.0f / 3.0f;
         const float oneThree = 1.0f / 3.0f;
 
-        std::vector<glm::vec3> gFieldVector = { gField.g0,gField.g1,gField.g2 };
-        std::vector<glm::vec3> cFieldVector = { cField.c0,cField.C05,cField.c1 };
+        std::array<glm::vec3, 3> gFieldVector = { gField.g0,gField.g1,gField.g2 };
+        std::array<glm::vec3, 3> cFieldVector = { cField.c0,cField.C05,cField.c1 };
 
         b1DField.d0 = k0 * gField.g0 + h0 * cField.c0;
         b1DField.d1 = (k0 * twoThree + k1 * oneThree) * BezierValue(gFieldVector, oneThree)
@@ -331,7 +334,7 @@ namespace CADMageddon
     }
 
 
-    FillingData GregoryPatch::GetFillingData(Fill fill) const
+    void GregoryPatch::UpdateFillingData()
     {
         ///      p1
         ///  b2 /  \ b3
@@ -339,55 +342,32 @@ namespace CADMageddon
         //// p0 ---- p2
         ///      b1
 
-        auto boundaryCurves = GetBoundaryCurvePoints();
-
-        auto b1Border = GetBorderPoints(b1, m_Border[0]);
-        auto b2Border = GetBorderPoints(b2, m_Border[1]);
-        auto b3Border = GetBorderPoints(b3, m_Border[2]);
+        BorderPoints borders[3] =
+        {
+            GetBorderPoints(b1, m_Border[0]),
+            GetBorderPoints(b2, m_Border[1]),
+            GetBorderPoints(b3, m_Border[2])
+        };
 
-        std::vector<glm::vec3> border;
-        std::vector<glm::vec3> borderLeft;
+        auto boundaryCurves = GetBoundaryCurvePoints(borders);
 
-        BoundaryCurve boundaryCurve, boundaryCurveLeft, boundaryCurveRight;
-        bool showMesh = false;
+        m_FillingData[(int)Fill::B12] = CalculateFillingData(borders[0], borders[1], boundaryCurves.p1, boundaryCurves.p2, boundaryCurves.p3);
+        m_FillingData[(int)Fill::B23] = CalculateFillingData(borders[1], borders[2], boundaryCurves.p2, boundaryCurves.p3, boundaryCurves.p1);
+        m_FillingData[(int)Fill::B31] = CalculateFillingData(borders[2], borders[0], boundaryCurves.p3, boundaryCurves.p1, boundaryCurves.p2);
+    }
 
-        switch (fill)
+    const FillingData& GregoryPatch::GetFillingData(Fill fill)
+    {
+        if (m_FillingDataRevision != m_Revision)
         {
-            case CADMageddon::Fill::B12:
-            {
-                border = b1Border;
-                borderLeft = b2Border;
-                boundaryCurve = boundaryCurves.p1;
-                boundaryCurveLeft = boundaryCurves.p2;
-                boundaryCurveRight = boundaryCurves.p3;
-                showMesh = m_ShowFirstMesh;
-            }
-            break;
-            case CADMageddon::Fill::B23:
-            {
-                border = b2Border;
-                borderLeft = b3Border;
-                boundaryCurve = boundaryCurves.p2;
-                boundaryCurveLeft = boundaryCurves.p3;
-                boundaryCurveRight = boundaryCurves.p1;
-                showMesh = m_ShowSecondMesh;
-                break;
-            }
-            case CADMageddon::Fill::B31:
-            {
-                border = b3Border;
-                borderLeft = b1Border;
-                boundaryCurve = boundaryCurves.p3;
-                boundaryCurveLeft = boundaryCurves.p1;
-                boundaryCurveRight = boundaryCurves.p2;
-                showMesh = m_ShowThirdMesh;
-                break;
-            }
-            default:
-                break;
+            UpdateFillingData();
+            m_FillingDataRevision = m_Revision;
         }
 
-
-        return GetFillingData(border, borderLeft, boundaryCurve, boundaryCurveLeft, boundaryCurveRight, showMesh);
+        //mesh visibility is toggled without invalidating the patch
+        bool showMesh[3] = { m_ShowFirstMesh, m_ShowSecondMesh, m_ShowThirdMesh };
+        auto& fillingData = m_FillingData[(int)fill];
+        fillingData.ShowMesh = showMesh[(int)fill];
+        return fillingData;
     }
 }
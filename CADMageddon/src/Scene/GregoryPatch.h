@@ -104,6 +104,13 @@ namespace CADMageddon
         bool ShowMesh = false;
     };
 
+    //border row of a patch along the hole and the row behind it, both starting at the same corner
+    struct BorderPoints
+    {
+        std::array<glm::vec3, 4> Inner;
+        std::array<glm::vec3, 4> Outer;
+    };
+
     struct GregoryCorner {
         glm::vec3 p, e[2], f[2];
     };
@@ -115,9 +122,10 @@ namespace CADMageddon
             Ref<BezierPatch> b1,
             Ref<BezierPatch> b2,
             Ref<BezierPatch> b3,
-            Ref<Point> commonPoints[3]);
+            PointHandle commonPoints[3]);
 
-        FillingData GetFillingData(Fill fill) const;
+        //all three fills are rebuilt together, only after one of b1, b2 or b3 changed
+        const FillingData& GetFillingData(Fill fill);
 
         int GetUDivisionCount() const { return m_UDivisionCount; }
         void SetUDivisionCount(int uDivisionCount) { m_UDivisionCount = uDivisionCount; }
@@ -145,28 +153,26 @@ namespace CADMageddon
         bool GetShowThirdMesh() const { return m_ShowThirdMesh; }
         void SetShowThirdMesh(bool showThird) { m_ShowThirdMesh = showThird; }
 
+    protected:
+        //the patch has no control points of its own, the scene invalidates it through b1, b2 and b3
+        virtual void RecalculateBoundingBox() override;
 
     private:
         GregoryPatch(std::string name, Border border[3]);
-        static std::vector<glm::vec3> GetSecondHalfBezier(std::vector<glm::vec3> curve);
-        static std::vector<glm::vec3> GetFirstHalfBezier(std::vector<glm::vec3> curve);
-        static glm::vec3 BezierValue(std::vector<glm::vec3> curve, float t);
-        static glm::vec3 BezierFirstDerivativeValue(std::vector<glm::vec3> curve, float t);
-
         static CFieldVectors GetCField(BoundaryCurve curve);
         static GFieldVectors GetGField(glm::vec3 a0, glm::vec3 a3, glm::vec3 b0, glm::vec3 b3);
         static DFieldVectors GetDField(GFieldVectors gField, CFieldVectors cField);
-        BoundaryCurves GetBoundaryCurvePoints() const;
-
-        static Border GetBorderEnum(Ref<BezierPatch> b1, Ref<Point> p0, Ref<Point> p1);
-        static std::vector<glm::vec3> GetBorderPoints(Ref<BezierPatch> b, Border border);
-        FillingData GetFillingData(
-            std::vector<glm::vec3> border,
-            std::vector<glm::vec3> borderLeft,
-            BoundaryCurve boundaryCurve,
-            BoundaryCurve left,
-            BoundaryCurve right,
-            bool showMesh) const;
+        static BoundaryCurves GetBoundaryCurvePoints(const BorderPoints borders[3]);
+
+        static Border GetBorderEnum(const Ref<BezierPatch>& b1, PointHandle p0, PointHandle p1);
+        static BorderPoints GetBorderPoints(const Ref<BezierPatch>& b, Border border);
+        static FillingData CalculateFillingData(
+            const BorderPoints& border,
+            const BorderPoints& borderLeft,
+            const BoundaryCurve& boundaryCurve,
+            const BoundaryCurve& left,
+            const BoundaryCurve& right);
+        void UpdateFillingData();
 
     private:
         int m_UDivisionCount = 4;
@@ -185,5 +191,9 @@ namespace CADMageddon
         Ref<BezierPatch> b1;
         Ref<BezierPatch> b2;
         Ref<BezierPatch> b3;
+
+        //indexed by Fill
+        FillingData m_FillingData[3];
+        uint64_t m_FillingDataRevision = 0;
     };
 }
\ No newline at end of file
@@ -2,70 +2,146 @@
 
 namespace CADMageddon
 {
-    std::vector<glm::vec3> CADMageddon::InterpolatedCurve::GetBezierControlPoints() const
+    const std::vector<glm::vec3>& InterpolatedCurve::GetBezierControlPoints()
     {
-        if (m_ControlPoints.empty())
-            return std::vector<glm::vec3 >();
-
-        std::vector<glm::vec3> knots;
-        for (int i = 0; i < m_ControlPoints.size(); i++) {
-            glm::vec3 knot = m_ControlPoints[i]->GetPosition();
-            if (i == 0 || knot != knots[knots.size() - 1])
-                knots.emplace_back(knot);
+        if (m_BezierControlPointsRevision != m_Revision)
+        {
+            CalculateBezierControlPoints();
+            m_BezierControlPointsRevision = m_Revision;
+        }
+
+        return m_BezierControlPoints;
+    }
+
+    void InterpolatedCurve::CalculateBezierControlPoints()
+    {
+        //repeated knots would give zero length segments
+        m_NewKnots.clear();
+        for (auto point : m_ControlPoints)
+        {
+            glm::vec3 knot = PointStore::Get().GetPosition(point);
+            if (m_NewKnots.empty() || knot != m_NewKnots.back())
+                m_NewKnots.push_back(knot);
+        }
+
+        int knotCount = m_NewKnots.size();
+        if (knotCount != m_Knots.size())
+        {
+            m_Knots.swap(m_NewKnots);
+            m_Distances.resize(std::max(knotCount - 1, 0));
+            m_Alfa.resize(knotCount);
+            m_Beta.resize(knotCount);
+            m_RightHandSide.resize(knotCount);
+            m_Moments.assign(knotCount, glm::vec3(0.0f));
+            m_BezierControlPoints.resize(knotCount > 0 ? 3 * knotCount - 2 : 0);
+
+            if (knotCount > 0)
+                Solve(0, knotCount - 1);
+
+            return;
         }
-        int knotCount = knots.size();
-        std::vector<glm::vec3> a(knotCount - 1), b(knotCount - 1), c(knotCount), d(knotCount - 1);
-        std::vector<float> alfa(knotCount - 1), beta(knotCount - 1), diag(knotCount - 1),
-            dist(knotCount - 1);
-        std::vector<glm::vec3> bezierPoints(3 * knotCount - 2);
-        for (int i = 0; i < knotCount - 1; i++)
-            dist[i] = glm::distance(knots[i], knots[i + 1]);
-        for (int i = 1; i < knotCount - 1; i++) {
-            alfa[i] = dist[i - 1] / (dist[i - 1] + dist[i]);
-            beta[i] = dist[i] / (dist[i - 1] + dist[i]);
-            diag[i] = 2;
-            c[i] = 3.f * ((knots[i + 1] - knots[i]) / dist[i] -
-                (knots[i] - knots[i - 1]) / dist[i - 1]) / (dist[i - 1] + dist[i]);
+
+        int firstMoved = 0;
+        while (firstMoved < knotCount && m_NewKnots[firstMoved] == m_Knots[firstMoved])
+            firstMoved++;
+
+        if (firstMoved == knotCount)
+            return;
+
+        int lastMoved = knotCount - 1;
+        while (m_NewKnots[lastMoved] == m_Knots[lastMoved])
+            lastMoved--;
+
+        std::copy(m_NewKnots.begin() + firstMoved, m_NewKnots.begin() + lastMoved + 1, m_Knots.begin() + firstMoved);
+        Solve(firstMoved, lastMoved);
+    }
+
+    void InterpolatedCurve::Solve(int firstMoved, int lastMoved)
+    {
+        int knotCount = m_Knots.size();
+
+        //chord lengths next to the moved knots and the rows using them
+        for (int i = std::max(0, firstMoved - 1); i <= std::min(knotCount - 2, lastMoved); i++)
+            m_Distances[i] = glm::distance(m_Knots[i], m_Knots[i + 1]);
+
+        for (int i = std::max(1, firstMoved - 1); i <= std::min(knotCount - 2, lastMoved + 1); i++)
+        {
+            float length = m_Distances[i - 1] + m_Distances[i];
+            m_Alfa[i] = m_Distances[i - 1] / length;
+            m_Beta[i] = m_Distances[i] / length;
+            m_RightHandSide[i] = 3.f * ((m_Knots[i + 1] - m_Knots[i]) / m_Distances[i] -
+                (m_Knots[i] - m_Knots[i - 1]) / m_Distances[i - 1]) / length;
         }
 
-        //solving equation
-        if (knotCount > 2) {
-            beta[1] /= diag[1];
-            c[1] /= diag[1];
-            for (int i = 2; i < knotCount - 1; i++) {
-                float m = 1.0f / (diag[i] - alfa[i] * beta[i - 1]);
-                beta[i] *= m;
-                c[i] = (c[i] - alfa[i] * c[i - 1]) * m;
-            }
-            for (int i = knotCount - 3; i > 1; i--)
-                c[i] -= beta[i] * c[i + 1];
-            c[1] -= beta[1] * c[2];
+        //a change in one row at least halves with every row away from it (diagonal 2 against alfa + beta = 1),
+        //SolveBandMargin rows further it is below float precision and the moments there are kept
+        int firstRow = std::max(1, firstMoved - 1 - SolveBandMargin);
+        int lastRow = std::min(knotCount - 2, lastMoved + 1 + SolveBandMargin);
+        SolveBand(firstRow, lastRow);
+
+        int firstSegment = std::max(0, std::min(firstRow, firstMoved) - 1);
+        int lastSegment = std::min(knotCount - 2, std::max(lastRow, lastMoved));
+        for (int i = firstSegment; i <= lastSegment; i++)
+        {
+            float dist = m_Distances[i];
+            glm::vec3 a = m_Knots[i];
+            glm::vec3 c = m_Moments[i] * dist * dist;
+            glm::vec3 d = (m_Moments[i + 1] - m_Moments[i]) / (3.f * dist) * dist * dist * dist;
+            glm::vec3 b = m_Knots[i + 1] - a - c - d;
+
+            m_BezierControlPoints[3 * i] = m_Knots[i];
+            m_BezierControlPoints[3 * i + 1] = a + 1.f / 3.f * b;
+            m_BezierControlPoints[3 * i + 2] = a + 2.f / 3.f * b + 1.f / 3.f * c;
         }
-        c[0] = c[knotCount - 1] = glm::vec3(0);
-
-        for (int i = 0; i < knotCount - 1; i++) {
-            a[i] = knots[i];
-            d[i] = (c[i + 1] - c[i]) / (3.f * dist[i]);
-            c[i] *= dist[i] * dist[i];
-            d[i] *= dist[i] * dist[i] * dist[i];
-            b[i] = knots[i + 1] - a[i] - c[i] - d[i];
-
-            bezierPoints[3 * i] = knots[i];
-            bezierPoints[3 * i + 1] = a[i] + 1.f / 3.f * b[i];
-            bezierPoints[3 * i + 2] = a[i] + 2.f / 3.f * b[i] + 1.f / 3.f * c[i];
+
+        m_BezierControlPoints[3 * knotCount - 3] = m_Knots[knotCount - 1];
+    }
+
+    void InterpolatedCurve::SolveBand(int firstRow, int lastRow)
+    {
+        int rowCount = lastRow - firstRow + 1;
+        if (rowCount <= 0)
+            return;
+
+        //thomas algorithm on the band, the moments just outside it enter as known values
+        m_SweepBeta.resize(rowCount);
+        m_SweepRightHandSide.resize(rowCount);
+        for (int k = 0; k < rowCount; k++)
+        {
+            int i = firstRow + k;
+            glm::vec3 rightHandSide = m_RightHandSide[i];
+            if (k == 0)
+                rightHandSide -= m_Alfa[i] * m_Moments[i - 1];
+            if (k == rowCount - 1)
+                rightHandSide -= m_Beta[i] * m_Moments[i + 1];
+
+            float alfa = k > 0 ? m_Alfa[i] : 0.0f;
+            float beta = k < rowCount - 1 ? m_Beta[i] : 0.0f;
+            float previousBeta = k > 0 ? m_SweepBeta[k - 1] : 0.0f;
+            glm::vec3 previousRightHandSide = k > 0 ? m_SweepRightHandSide[k - 1] : glm::vec3(0.0f);
+
+            float m = 1.0f / (2.0f - alfa * previousBeta);
+            m_SweepBeta[k] = beta * m;
+            m_SweepRightHandSide[k] = (rightHandSide - alfa * previousRightHandSide) * m;
         }
 
-        bezierPoints[3 * knotCount - 3] = knots[knotCount - 1];
-        return bezierPoints;
+        m_Moments[lastRow] = m_SweepRightHandSide[rowCount - 1];
+        for (int k = rowCount - 2; k >= 0; k--)
+            m_Moments[firstRow + k] = m_SweepRightHandSide[k] - m_SweepBeta[k] * m_Moments[firstRow + k + 1];
     }
 
     void InterpolatedCurve::SetShowPoints(bool setShowPoints)
     {
         m_ShowPoints = setShowPoints;
-        for (auto point : m_ControlPoints)
-        {
-            point->SetIsVisible(setShowPoints);
-        }
+        SetControlPointsVisible(setShowPoints);
+    }
+
+    void InterpolatedCurve::RecalculateBoundingBox()
+    {
+        //interpolating curve can overshoot its knots, bound it by the bezier polygon instead
+        BaseObject::RecalculateBoundingBox();
+        for (const auto& point : GetBezierControlPoints())
+            m_BoundingBox.Expand(point);
     }
 }
 
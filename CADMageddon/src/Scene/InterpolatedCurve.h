@@ -9,7 +9,8 @@ namespace CADMageddon
     {
     public:
         InterpolatedCurve(std::string name) :Curve(name) {}
-        std::vector<glm::vec3> GetBezierControlPoints() const;
+        //rebuilt only after the curve was invalidated
+        const std::vector<glm::vec3>& GetBezierControlPoints();
 
         bool GetShowPolygon() const { return m_ShowPolygon; }
         void SetShowPolygon(bool showPolygon) { m_ShowPolygon = showPolygon; }
@@ -17,8 +18,35 @@ namespace CADMageddon
         bool GetShowPoints() const { return m_ShowPoints; }
         void SetShowPoints(bool setShowPoints);
 
+    protected:
+        virtual void RecalculateBoundingBox() override;
+
+    private:
+        static constexpr int SolveBandMargin = 32;
+
+        void CalculateBezierControlPoints();
+        //updates the system for knots firstMoved..lastMoved and re-solves the band of rows they affect
+        void Solve(int firstMoved, int lastMoved);
+        void SolveBand(int firstRow, int lastRow);
+
     private:
         bool m_ShowPoints = true;
         bool m_ShowPolygon = false;
+
+        std::vector<glm::vec3> m_BezierControlPoints;
+        uint64_t m_BezierControlPointsRevision = 0;
+
+        //chord length parametrized C2 spline through the knots, kept between changes so moving
+        //a knot re-solves only the rows around it, moments are zero at both ends
+        std::vector<glm::vec3> m_Knots;
+        std::vector<float> m_Distances;
+        std::vector<float> m_Alfa;
+        std::vector<float> m_Beta;
+        std::vector<glm::vec3> m_RightHandSide;
+        std::vector<glm::vec3> m_Moments;
+
+        std::vector<glm::vec3> m_NewKnots;
+        std::vector<float> m_SweepBeta;
+        std::vector<glm::vec3> m_SweepRightHandSide;
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "IntersectionCurve.h"
 #include "LineClipper.h"
+#include "Rendering\Renderer.h"
 #include <glad\glad.h>
 
 namespace CADMageddon
@@ -8,14 +9,18 @@ namespace CADMageddon
     {
         auto interpolated = CreateRef<InterpolatedCurve>(name);
         for (int i = 0; i < m_IntersectionPoints.size(); i++)
-        {
-            auto point = CreateRef<Point>(m_IntersectionPoints[i].Location, name + "_Point_" + std::to_string(i));
-            interpolated->AddControlPoint(point);
-        }
+            interpolated->CreateControlPoint(m_IntersectionPoints[i].Location, name + "_Point_" + std::to_string(i));
 
         return interpolated;
     }
 
+    void IntersectionCurve::RecalculateBoundingBox()
+    {
+        m_BoundingBox.Reset();
+        for (const auto& intersectionPoint : m_IntersectionPoints)
+            m_BoundingBox.Expand(intersectionPoint.Location);
+    }
+
     void IntersectionCurve::CalculateTrimming(int lineCount, bool isFirst)
     {
         /* int index = isFirst ? 0 : 1;
@@ -174,7 +179,24 @@ namespace CADMageddon
             }
         }
 
-        m_Shader = CreateRef<OpenGLShader>("assets/shaders/TrimTextureShader.glsl");
+        std::vector<glm::vec3> locations;
+        locations.reserve(m_IntersectionPoints.size());
+        for (const auto& intersectionPoint : m_IntersectionPoints)
+            locations.push_back(intersectionPoint.Location);
+
+        //the curve never changes after it is traced, so it is uploaded once instead of batched every frame
+        if (!locations.empty())
+        {
+            auto lineVertexBuffer = CreateRef<OpenGLVertexBuffer>(&locations[0].x, locations.size() * sizeof(glm::vec3));
+            lineVertexBuffer->SetLayout({
+                { ShaderDataType::Float3, "a_Position" }
+                });
+
+            m_LineVertexArray = CreateRef<OpenGLVertexArray>();
+            m_LineVertexArray->AddVertexBuffer(lineVertexBuffer);
+        }
+
+        m_Shader = Renderer::GetShader("TrimTextureShader");
         m_Shader->Bind();
 
         if (intersectionType == IntersectionType::ClosedClosed || intersectionType == IntersectionType::ClosedOpen)
@@ -35,7 +35,9 @@ namespace CADMageddon
             IntersectionType intersectionType,
             std::vector<IntersectionPoint> intersectionPoints);
 
-        std::vector<IntersectionPoint> GetIntersectionPoints() const { return m_IntersectionPoints; }
+        const std::vector<IntersectionPoint>& GetIntersectionPoints() const { return m_IntersectionPoints; }
+        //the curve locations uploaded once at creation, drawn as a single line strip
+        const Ref<OpenGLVertexArray>& GetLineVertexArray() const { return m_LineVertexArray; }
         Ref<InterpolatedCurve> ConvertToInterpolated(std::string name);
 
         Ref<SurfaceUV> GetFirstSurface() { return m_FirstSurface; }
@@ -53,11 +55,11 @@ namespace CADMageddon
         unsigned int GetSecondSurfaceTrimmedWithBounds() const { return m_TrimInsideWithBoundary[1]; }
 
 
-        std::vector<std::vector<glm::vec2>> GetFirstSurfaceDomainLoops() const { return m_DomainLoops[0]; }
-        std::vector<std::vector<glm::vec2>> GetSecondSurfaceDomainLoops() const { return m_DomainLoops[1]; }
+        const std::vector<std::vector<glm::vec2>>& GetFirstSurfaceDomainLoops() const { return m_DomainLoops[0]; }
+        const std::vector<std::vector<glm::vec2>>& GetSecondSurfaceDomainLoops() const { return m_DomainLoops[1]; }
 
-        std::vector<std::vector<glm::vec2>> GetFirstBoundary() const { return m_Boundary[0]; }
-        std::vector<std::vector<glm::vec2>> GetSecondBoundary() const { return m_Boundary[1]; }
+        const std::vector<std::vector<glm::vec2>>& GetFirstBoundary() const { return m_Boundary[0]; }
+        const std::vector<std::vector<glm::vec2>>& GetSecondBoundary() const { return m_Boundary[1]; }
 
 
         /*std::vector<glm::vec2> GetFirstSurfaceIntersectionLines() const { return m_IntersectionLines[0]; }
@@ -65,6 +67,10 @@ namespace CADMageddon
 
         void CalculateTrimming(int lineCount, bool isFirst);
 
+    protected:
+        //traced once, the curve has no control points to take the box from
+        virtual void RecalculateBoundingBox() override;
+
     private:
         Ref<OpenGLFramebuffer> m_FrameBuffer[2];
         Ref<OpenGLShader> m_Shader;
@@ -124,6 +130,7 @@ namespace CADMageddon
         std::vector<std::vector<glm::vec2>> m_Boundary[2];
 
         std::vector<IntersectionPoint> m_IntersectionPoints;
+        Ref<OpenGLVertexArray> m_LineVertexArray;
         Ref<SurfaceUV> m_FirstSurface;
         Ref<SurfaceUV> m_SecondSurface;
 
@@ -8,6 +8,7 @@ namespace CADMageddon
     struct Mesh
     {
         std::vector<glm::vec3> Vertices;
+        std::vector<glm::vec2> TextureCoordinates;
         std::vector<uint32_t> Indices;
     };
 }
\ No newline at end of file
@@ -24,7 +24,12 @@ namespace CADMageddon
     {
         Mesh mesh;
 
+        int vertexCount = (majorRadiusCount + 1) * (minorRadiusCount + 1);
         std::vector<glm::vec3> vertices;
+        std::vector<glm::vec2> textureCoordinates;
+        vertices.reserve(vertexCount);
+        textureCoordinates.reserve(vertexCount);
+
         float uBegin = 0.0f;
         constexpr float uEnd = glm::two_pi<float>();
         float uDelta = (uEnd - uBegin) / majorRadiusCount;
@@ -40,10 +45,12 @@ namespace CADMageddon
             {
                 float actualV = vBegin + vIndex * vDelta;
                 vertices.push_back(GetTorusPoint(majorRadius, minorRadius, actualU, actualV));
+                textureCoordinates.push_back(glm::vec2((float)uIndex / majorRadiusCount, (float)vIndex / minorRadiusCount));
             }
         }
 
         std::vector<uint32_t> indices;
+        indices.reserve(majorRadiusCount * minorRadiusCount * 4);
         for (int uIndex = 0; uIndex < majorRadiusCount; uIndex++)
         {
             for (int vIndex = 0; vIndex < minorRadiusCount; vIndex++)
@@ -61,57 +68,9 @@ namespace CADMageddon
         }
 
 
-        mesh.Vertices = vertices;
-        mesh.Indices = indices;
-
-        return mesh;
-    }
-
-    Mesh ObjectFactory::CreateGridMesh(float width, float height)
-    {
-        Mesh mesh;
-        //auto widthDelta = width / spacingHorizontal;
-        //auto heightDelta = height / spacingVertical;
-
-        auto halfWidth = width / 2.0f;
-        auto halfHeight = height / 2.0f;
-
-        std::vector<glm::vec3> vertices;
-        for (auto u = -halfWidth; u <= halfWidth; u += 4.0f)
-        {
-            for (auto v = -halfHeight; v <= halfHeight; v += 4.0f)
-            {
-                vertices.push_back(glm::vec3(u, v, 0));
-            }
-        }
-
-        int WidthCount = static_cast<int>(width / 4.0f) + 1;
-        int HeightCount = static_cast<int>(height / 4.0f) + 1;
-
-        std::vector<uint32_t> indices;
-
-        for (int widthIndex = 0; widthIndex < WidthCount; widthIndex++)
-        {
-            for (int heightIndex = 0; heightIndex < HeightCount; heightIndex++)
-            {
-                int currentIndex = widthIndex * HeightCount + heightIndex;
-                int nextRowIndex = currentIndex + HeightCount;
-                int nextIndex = currentIndex + 1;
-                if (nextIndex < widthIndex * HeightCount + HeightCount)
-                {
-                    indices.push_back(currentIndex);
-                    indices.push_back(nextIndex);
-                }
-                if (nextRowIndex < WidthCount * HeightCount)
-                {
-                    indices.push_back(currentIndex);
-                    indices.push_back(nextRowIndex);
-                }
-            }
-        }
-
-        mesh.Vertices = vertices;
-        mesh.Indices = indices;
+        mesh.Vertices = std::move(vertices);
+        mesh.TextureCoordinates = std::move(textureCoordinates);
+        mesh.Indices = std::move(indices);
 
         return mesh;
     }
@@ -11,11 +11,5 @@ namespace CADMageddon
             float minorRadius = 1.0f,
             int majorRadiusCount = 30,
             int minorRadiusCount = 10);
-
-        static Mesh CreateGridMesh(
-            float width = 100.0f,
-            float height = 100.0f
-            /*float spacingHorizontal = 1.0f,
-            float spacingVertical = 1.0f*/);
     };
 }
\ No newline at end of file
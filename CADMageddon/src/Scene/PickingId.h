@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+namespace CADMageddon
+{
+    enum class PickingType : uint32_t
+    {
+        None = 0,
+        Point,
+        Torus,
+        BezierC0,
+        BSpline,
+        InterpolatedCurve,
+        BezierPatch,
+        BSplinePatch,
+        GregoryPatch,
+        IntersectionCurve
+    };
+
+    //value written into the picking attachment, object type in the high byte and its scene entity below it
+    //0 is the background so valid ids always have a type
+    struct PickingId
+    {
+        static constexpr uint32_t IndexBits = 24;
+        static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+
+        //the entity index takes the low 20 bits, the spare ones keep the low bits of the entity version
+        //so an id read back after its entity was deleted does not resolve to the entity reusing the slot
+        static constexpr uint32_t EntityBits = 20;
+        static constexpr uint32_t EntityMask = (1u << EntityBits) - 1;
+        static constexpr uint32_t VersionMask = (1u << (IndexBits - EntityBits)) - 1;
+
+        static uint32_t Encode(PickingType type, uint32_t index) { return ((uint32_t)type << IndexBits) | (index & IndexMask); }
+        static PickingType GetType(uint32_t id) { return (PickingType)(id >> IndexBits); }
+        static uint32_t GetIndex(uint32_t id) { return id & IndexMask; }
+
+        static uint32_t EncodeEntity(uint32_t entity, uint32_t version) { return (entity & EntityMask) | ((version & VersionMask) << EntityBits); }
+        static uint32_t GetEntity(uint32_t index) { return index & EntityMask; }
+        static uint32_t GetVersion(uint32_t index) { return (index >> EntityBits) & VersionMask; }
+    };
+}
@@ -4,55 +4,62 @@
 #include <glm\glm.hpp>
 #include <glm\gtc\matrix_inverse.hpp>
 #include "Transform.h"
-#include "Core\Base.h"
+#include "PointStore.h"
+#include "SceneEntity.h"
 
 namespace CADMageddon
 {
-    class Point
+    // Owns one slot of the PointStore, the data itself lives there next to all other points.
+    class Point : public std::enable_shared_from_this<Point>
     {
     public:
-        Point() : m_Name("Point")
-        {
-            m_Transform = CreateRef<Transform>();
-        }
+        Point() : Point(glm::vec3(0.0f)) {}
 
-        Point(glm::vec3& position) : m_Name("Point")
+        Point(const glm::vec3& position, const std::string& name = "Point")
         {
-            m_Transform = CreateRef<Transform>();
-            m_Transform->Translation = position;
+            m_Handle = PointStore::Get().Create(position, name, this);
         }
 
-        Point(const glm::vec3& position, const std::string& name = "Point")
-            : m_Name(name)
+        //the point behind a handle kept by an object, null once the point is gone
+        static Ref<Point> FromHandle(PointHandle handle)
         {
-            m_Transform = CreateRef<Transform>();
-            m_Transform->Translation = position;
+            auto point = PointStore::Get().GetPoint(handle);
+            return point ? point->shared_from_this() : nullptr;
         }
 
-        std::string GetName() const { return m_Name; }
-        void SetName(const std::string& name) { m_Name = name; }
+        ~Point() { PointStore::Get().Destroy(m_Handle); }
+
+        //the slot is released with the point, copies would release it twice
+        Point(const Point&) = delete;
+        Point& operator=(const Point&) = delete;
 
-        Ref<Transform> GetTransform() { return m_Transform; }
-        void SetTransform(Ref<Transform> transform) { m_Transform = transform; }
+        PointHandle GetHandle() const { return m_Handle; }
+        SceneEntity& GetEntity() { return m_Entity; }
 
-        bool GetIsSelected() const { return m_IsSelected; }
-        void SetIsSelected(bool isSelected) { m_IsSelected = isSelected; }
+        std::string GetName() const { return PointStore::Get().GetName(m_Handle); }
+        void SetName(const std::string& name) { PointStore::Get().SetName(m_Handle, name); }
 
-        glm::vec3 GetPosition() { return m_Transform->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); }
+        //lives in the point's slot, do not keep it past the point, keep the handle instead
+        Transform& GetTransform() { return PointStore::Get().GetTransform(m_Handle); }
 
-        bool GetIsVisible() const { return m_IsVisible; }
-        void SetIsVisible(bool visible) { m_IsVisible = visible; }
+        bool GetIsSelected() const { return PointStore::Get().HasFlag(m_Handle, PointFlagSelected); }
+        void SetIsSelected(bool isSelected)
+        {
+            PointStore::Get().SetFlag(m_Handle, PointFlagSelected, isSelected);
+            m_Entity.SetTag<SelectedComponent>(isSelected);
+        }
+
+        glm::vec3 GetPosition() { return PointStore::Get().GetPosition(m_Handle); }
 
-        int GetReferencedCount() const { return m_ReferencedCount; }
-        void SetReferencedCount(int referencedCount) { m_ReferencedCount = referencedCount; }
+        bool GetIsVisible() const { return PointStore::Get().HasFlag(m_Handle, PointFlagVisible); }
+        void SetIsVisible(bool visible)
+        {
+            PointStore::Get().SetFlag(m_Handle, PointFlagVisible, visible);
+            m_Entity.SetTag<VisibleComponent>(visible);
+        }
 
     private:
-        Ref<Transform> m_Transform;
-        std::string m_Name;
-        glm::vec3 m_Position = { 0.0f,0.0f,0.0f };
-        bool m_IsSelected = false;
-        bool m_IsVisible = true;
-        int m_ReferencedCount = 0;
+        PointHandle m_Handle;
+        SceneEntity m_Entity;
     };
 }
-
@@ -0,0 +1,128 @@
+#include "PointStore.h"
+
+namespace CADMageddon
+{
+    PointStore& PointStore::Get()
+    {
+        static PointStore* s_Instance = new PointStore();
+        return *s_Instance;
+    }
+
+    PointHandle PointStore::Create(const glm::vec3& position, const std::string& name, Point* point)
+    {
+        uint32_t index;
+        if (!m_FreeSlots.empty())
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            index = (uint32_t)m_Generations.size();
+            m_Generations.push_back(0);
+            m_Positions.emplace_back();
+            if (index / ChunkSize == m_Chunks.size())
+                m_Chunks.push_back(CreateScope<Chunk>());
+        }
+
+        auto& chunk = GetChunk(index);
+        uint32_t slot = index % ChunkSize;
+
+        chunk.Transforms[slot] = Transform();
+        chunk.Transforms[slot].SetChangeList(&m_Changed, index);
+        chunk.Transforms[slot].SetTranslation(position);
+        chunk.Points[slot] = point;
+        chunk.Names[slot] = name;
+        m_Positions[index] = position;
+        chunk.Flags[slot] = PointFlagAlive | PointFlagVisible;
+
+        return PointHandle{ index, m_Generations[index] };
+    }
+
+    void PointStore::Destroy(PointHandle handle)
+    {
+        if (!IsAlive(handle))
+            return;
+
+        auto& chunk = GetChunk(handle.Index);
+        uint32_t slot = handle.Index % ChunkSize;
+
+        //drop the parent reference and the name's heap buffer now rather than when the slot is reused
+        chunk.Transforms[slot] = Transform();
+        chunk.Points[slot] = nullptr;
+        chunk.Names[slot] = std::string();
+        chunk.Flags[slot] = 0;
+
+        m_Generations[handle.Index]++;
+        m_FreeSlots.push_back(handle.Index);
+    }
+
+    void PointStore::TakeMoved(std::vector<PointHandle>& moved)
+    {
+        UpdatePositions();
+
+        std::sort(m_Moved.begin(), m_Moved.end());
+        m_Moved.erase(std::unique(m_Moved.begin(), m_Moved.end()), m_Moved.end());
+
+        moved.clear();
+        for (auto index : m_Moved)
+        {
+            //a released slot stays listed, it is skipped until reused
+            if (GetFlags(index) & PointFlagAlive)
+                moved.push_back(PointHandle{ index, m_Generations[index] });
+        }
+
+        m_Moved.clear();
+    }
+
+    void PointStore::RecalculatePositions()
+    {
+        m_PositionsChangeCount = Transform::GetChangeCount();
+
+        std::sort(m_Changed.begin(), m_Changed.end());
+        m_Changed.erase(std::unique(m_Changed.begin(), m_Changed.end()), m_Changed.end());
+
+        for (auto index : m_Changed)
+        {
+            if (!(GetFlags(index) & PointFlagAlive))
+                continue;
+
+            //a parent is set by a change, clearing it is caught below
+            bool following = GetChunk(index).Transforms[index % ChunkSize].GetParent() != nullptr;
+            if (following && std::find(m_Following.begin(), m_Following.end(), index) == m_Following.end())
+                m_Following.push_back(index);
+
+            RecalculatePosition(index);
+        }
+
+        m_Changed.clear();
+
+        //released slots and points without a parent leave the list, a reused slot is listed again by its first change
+        m_Following.erase(std::remove_if(m_Following.begin(), m_Following.end(), [this](uint32_t index)
+            {
+                return !(GetFlags(index) & PointFlagAlive) || GetChunk(index).Transforms[index % ChunkSize].GetParent() == nullptr;
+            }), m_Following.end());
+
+        for (auto index : m_Following)
+            RecalculatePosition(index);
+    }
+
+    void PointStore::RecalculatePosition(uint32_t index)
+    {
+        glm::vec3 position = GetChunk(index).Transforms[index % ChunkSize].GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        if (position != m_Positions[index])
+        {
+            m_Positions[index] = position;
+            m_Moved.push_back(index);
+        }
+    }
+
+    void PointStore::SetFlag(PointHandle handle, PointFlags flag, bool value)
+    {
+        auto& flags = GetChunk(handle.Index).Flags[handle.Index % ChunkSize];
+        if (value)
+            flags |= flag;
+        else
+            flags &= ~flag;
+    }
+}
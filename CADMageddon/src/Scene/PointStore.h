@@ -0,0 +1,115 @@
+#pragma once
+#include "cadpch.h"
+#include "Core\Base.h"
+#include "Transform.h"
+#include <glm\glm.hpp>
+
+namespace CADMageddon
+{
+    class Point;
+
+    // Index of a slot in the PointStore. The generation changes whenever the slot is released,
+    // so a handle kept after its point was destroyed no longer resolves.
+    struct PointHandle
+    {
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFF;
+
+        uint32_t Index = InvalidIndex;
+        uint32_t Generation = 0;
+
+        bool IsValid() const { return Index != InvalidIndex; }
+
+        bool operator==(const PointHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+        bool operator!=(const PointHandle& other) const { return !(*this == other); }
+    };
+
+    struct PointHandleHash
+    {
+        size_t operator()(const PointHandle& handle) const { return std::hash<uint64_t>()(((uint64_t)handle.Generation << 32) | handle.Index); }
+    };
+
+    enum PointFlags : uint8_t
+    {
+        PointFlagAlive = 1 << 0,
+        PointFlagSelected = 1 << 1,
+        PointFlagVisible = 1 << 2
+    };
+
+    // Storage of every point's data in parallel arrays. The arrays are split into fixed size chunks
+    // so a transform keeps its address while the store grows. World positions are kept apart in one
+    // dense array indexed by the handle, refreshed from the transforms when any of them changed.
+    class PointStore
+    {
+    public:
+        static constexpr uint32_t ChunkSize = 1024;
+
+        //never destroyed, points released during static destruction still find it
+        static PointStore& Get();
+
+        PointHandle Create(const glm::vec3& position, const std::string& name, Point* point);
+        void Destroy(PointHandle handle);
+
+        bool IsAlive(PointHandle handle) const
+        {
+            return handle.Index < m_Generations.size() && m_Generations[handle.Index] == handle.Generation
+                && (GetFlags(handle.Index) & PointFlagAlive);
+        }
+
+        //the point owning the slot, null once it is released
+        Point* GetPoint(PointHandle handle) const { return IsAlive(handle) ? GetChunk(handle.Index).Points[handle.Index % ChunkSize] : nullptr; }
+
+        Transform& GetTransform(PointHandle handle) { return GetChunk(handle.Index).Transforms[handle.Index % ChunkSize]; }
+        const std::string& GetName(PointHandle handle) const { return GetChunk(handle.Index).Names[handle.Index % ChunkSize]; }
+        void SetName(PointHandle handle, const std::string& name) { GetChunk(handle.Index).Names[handle.Index % ChunkSize] = name; }
+
+        bool HasFlag(PointHandle handle, PointFlags flag) const { return (GetFlags(handle.Index) & flag) != 0; }
+        void SetFlag(PointHandle handle, PointFlags flag, bool value);
+
+        glm::vec3 GetPosition(PointHandle handle)
+        {
+            UpdatePositions();
+            return m_Positions[handle.Index];
+        }
+
+        //points whose world position changed since the last call, each alive point once
+        //points following a parent are listed when only the parent moved too
+        void TakeMoved(std::vector<PointHandle>& moved);
+
+    private:
+        struct Chunk
+        {
+            Transform Transforms[ChunkSize];
+            Point* Points[ChunkSize] = {};
+            std::string Names[ChunkSize];
+            uint8_t Flags[ChunkSize] = {};
+        };
+
+        PointStore() = default;
+
+        Chunk& GetChunk(uint32_t index) { return *m_Chunks[index / ChunkSize]; }
+        const Chunk& GetChunk(uint32_t index) const { return *m_Chunks[index / ChunkSize]; }
+        uint8_t GetFlags(uint32_t index) const { return GetChunk(index).Flags[index % ChunkSize]; }
+
+        //cheap when no transform changed since the last update, see Transform::GetChangeCount
+        void UpdatePositions()
+        {
+            if (m_PositionsChangeCount != Transform::GetChangeCount())
+                RecalculatePositions();
+        }
+
+        void RecalculatePositions();
+        void RecalculatePosition(uint32_t index);
+
+    private:
+        std::vector<Scope<Chunk>> m_Chunks;
+        std::vector<uint32_t> m_Generations;
+        std::vector<uint32_t> m_FreeSlots;
+        std::vector<uint32_t> m_Changed;
+
+        std::vector<glm::vec3> m_Positions;
+        uint64_t m_PositionsChangeCount = 0;
+        //slots with a parent, their position follows transforms that are not theirs
+        std::vector<uint32_t> m_Following;
+        std::vector<uint32_t> m_Moved;
+    };
+}
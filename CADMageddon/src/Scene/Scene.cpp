@@ -1,5 +1,6 @@
 #include "Scene.h"
 #include "Rendering\Renderer.h"
+#include "Core\Profiler.h"
 
 namespace CADMageddon
 {
@@ -9,11 +10,136 @@ namespace CADMageddon
         m_DefaultColor = Renderer::DEFAULT_COLOR;
     }
 
+    Scene::~Scene()
+    {
+        DetachAll<Point>();
+        DetachAll<Torus>();
+        DetachAll<BezierC0>();
+        DetachAll<BSpline>();
+        DetachAll<InterpolatedCurve>();
+        DetachAll<BezierPatch>();
+        DetachAll<BSplinePatch>();
+        DetachAll<GregoryPatch>();
+        DetachAll<IntersectionCurve>();
+    }
+
+    static uint32_t GetPickingIndex(entt::entity entity)
+    {
+        auto index = (uint32_t)entt::to_integral(entt::registry::entity(entity));
+        return PickingId::EncodeEntity(index, (uint32_t)entt::registry::version(entity));
+    }
+
+    entt::entity Scene::GetEntityByPickingIndex(uint32_t pickingIndex) const
+    {
+        uint32_t entityIndex = PickingId::GetEntity(pickingIndex);
+        if (entityIndex >= m_Registry.size())
+            return entt::null;
+
+        using traits = entt::entt_traits<std::underlying_type_t<entt::entity>>;
+        auto version = m_Registry.current(entt::entity{ entityIndex });
+        //the slot was recycled since the id was written, the id names an entity that is gone
+        if (((uint32_t)version & PickingId::VersionMask) != PickingId::GetVersion(pickingIndex))
+            return entt::null;
+
+        auto entity = entt::entity{ entityIndex | ((uint32_t)version << traits::entity_shift) };
+        return m_Registry.valid(entity) ? entity : entt::null;
+    }
+
+    void Scene::AddOwner(PointHandle point, entt::entity owner)
+    {
+        auto [begin, end] = m_PointOwners.equal_range(point);
+        if (std::find_if(begin, end, [owner](const auto& entry) { return entry.second == owner; }) == end)
+            m_PointOwners.emplace(point, owner);
+    }
+
+    bool Scene::RemoveOwner(PointHandle point, entt::entity owner)
+    {
+        auto [begin, end] = m_PointOwners.equal_range(point);
+        auto it = std::find_if(begin, end, [owner](const auto& entry) { return entry.second == owner; });
+        if (it == end)
+            return false;
+
+        m_PointOwners.erase(it);
+        return true;
+    }
+
+    void Scene::ReleaseControlPoints(entt::entity owner, const std::vector<PointHandle>& points)
+    {
+        for (auto point : points)
+        {
+            if (RemoveOwner(point, owner) && m_PointOwners.count(point) == 0)
+            {
+                if (auto freePoint = Point::FromHandle(point))
+                    m_FreePoints.push_back(freePoint);
+            }
+        }
+    }
+
+    void Scene::AddDependent(entt::entity source, entt::entity dependent)
+    {
+        auto [begin, end] = m_Dependents.equal_range(source);
+        if (std::find_if(begin, end, [dependent](const auto& entry) { return entry.second == dependent; }) == end)
+            m_Dependents.emplace(source, dependent);
+    }
+
+    void Scene::RemoveDependent(entt::entity source, entt::entity dependent)
+    {
+        auto [begin, end] = m_Dependents.equal_range(source);
+        auto it = std::find_if(begin, end, [dependent](const auto& entry) { return entry.second == dependent; });
+        if (it != end)
+            m_Dependents.erase(it);
+    }
+
+    void Scene::InvalidateDerivedData(entt::entity entity)
+    {
+        if (auto derivedData = m_Registry.try_get<DerivedDataComponent>(entity))
+            derivedData->Object->Invalidate();
+
+        auto [begin, end] = m_Dependents.equal_range(entity);
+        for (auto it = begin; it != end; ++it)
+            InvalidateDerivedData(it->second);
+    }
+
+    void Scene::InvalidateOwners(PointHandle point)
+    {
+        auto [begin, end] = m_PointOwners.equal_range(point);
+        for (auto it = begin; it != end; ++it)
+            InvalidateDerivedData(it->second);
+    }
+
+    void Scene::PropagateChanges()
+    {
+        CDM_PROFILE_SCOPE("Scene::PropagateChanges");
+        //no transform changed since the last call
+        if (Transform::GetChangeCount() == m_PropagatedChangeCount)
+            return;
+
+        m_PropagatedChangeCount = Transform::GetChangeCount();
+
+        //points following a parent are listed by the store when only the parent moved
+        PointStore::Get().TakeMoved(m_MovedPoints);
+        for (auto point : m_MovedPoints)
+            InvalidateOwners(point);
+    }
+
+    void Scene::AddControlPoint(const Ref<Curve>& curve, const Ref<Point>& point)
+    {
+        curve->AddControlPoint(point->GetHandle());
+        AddOwner(point->GetHandle(), curve->GetEntity().GetHandle());
+    }
+
+    void Scene::RemoveControlPoint(const Ref<Curve>& curve, const Ref<Point>& point)
+    {
+        curve->RemoveControlPoint(point->GetHandle());
+        ReleaseControlPoints(curve->GetEntity().GetHandle(), { point->GetHandle() });
+    }
+
     static int pointCount = 0;
 
     void Scene::MergePoints(Ref<Point> p1, Ref<Point> p2)
     {
-        if (std::find_if(m_FreePoints.begin(), m_FreePoints.end(), [p1, p2](Ref<Point> p) {return p == p1 || p == p2; }) != m_FreePoints.end())
+        MarkDirty();
+        if (GetOwnerCount(p1) == 0 || GetOwnerCount(p2) == 0)
             return;
 
         static int mergedCount = 0;
@@ -21,38 +147,36 @@ namespace CADMageddon
         auto newPosition = (p1->GetPosition() + p2->GetPosition()) / 2.0f;
 
         auto newPoint = CreateRef<Point>(newPosition, newName);
-        int referenced = 0;
 
-        for (auto baseObject : m_BaseObjects)
+        //only the objects using one of the points have to be rewritten
+        std::vector<entt::entity> owners;
+        for (auto point : { p1->GetHandle(), p2->GetHandle() })
         {
-            auto& points = baseObject->GetControlPoints();
-            auto it = std::find(points.begin(), points.end(), p1);
-            auto it2 = std::find(points.begin(), points.end(), p2);
-            int  referencedIncrement = 0;
+            auto [begin, end] = m_PointOwners.equal_range(point);
+            for (auto it = begin; it != end; ++it)
+                owners.push_back(it->second);
 
-            while (it != points.end() || it2 != points.end())
-            {
-                referencedIncrement = 1;
+            m_PointOwners.erase(point);
+        }
 
-                if (it != points.end())
-                {
-                    *it = newPoint;
-                    it = std::find(it + 1, points.end(), p1);
-                }
-                if (it2 != points.end())
-                {
-                    *it2 = newPoint;
-                    it2 = std::find(it2 + 1, points.end(), p2);
-                }
-            }
-            referenced += referencedIncrement;
+        for (auto owner : owners)
+        {
+            auto& points = *m_Registry.get<ControlPointRefsComponent>(owner).Points;
+            std::replace(points.begin(), points.end(), p1->GetHandle(), newPoint->GetHandle());
+            std::replace(points.begin(), points.end(), p2->GetHandle(), newPoint->GetHandle());
+            AddOwner(newPoint->GetHandle(), owner);
+            InvalidateDerivedData(owner);
         }
 
+        //the merged point takes the place of the first one in the creation order
         auto it = std::find(m_Points.begin(), m_Points.end(), p1);
         *it = newPoint;
         it = std::find(m_Points.begin(), m_Points.end(), p2);
         m_Points.erase(it);
-        newPoint->SetReferencedCount(referenced);
+
+        Unregister(p1);
+        Unregister(p2);
+        Register(newPoint);
 
         if (m_onPointMerged)
             m_onPointMerged(p1, p2, newPoint);
@@ -60,8 +184,9 @@ namespace CADMageddon
 
     Ref<Point> Scene::CreatePoint(glm::vec3 position, std::string name)
     {
+        MarkDirty();
         auto point = CreateRef<Point>(position, name + std::to_string(pointCount++));
-        m_Points.push_back(point);
+        Add(point);
         auto added = AddNewPointToBezier(point);
         if (!added)
             added = AddNewPointToBSpline(point);
@@ -76,48 +201,47 @@ namespace CADMageddon
 
     Ref<Torus> Scene::CreateTorus(glm::vec3 position, std::string name)
     {
+        MarkDirty();
         static int torusCount = 0;
         auto torus = CreateRef<Torus>(position, name + std::to_string(torusCount++));
-        m_Torus.push_back(torus);
+        Add(torus);
         return torus;
     }
 
     Ref<BezierC0> Scene::CreateBezierC0(std::string name)
     {
+        MarkDirty();
         static int bezierC0Count = 0;
         auto bezierC0 = CreateRef<BezierC0>(name + std::to_string(bezierC0Count++));
-        m_BezierC0.push_back(bezierC0);
-        m_BaseObjects.insert(bezierC0);
+        Add(bezierC0);
         return bezierC0;
     }
 
     Ref<BSpline> Scene::CreateBSpline(std::string name)
     {
+        MarkDirty();
         static int bSplineCount = 0;
         auto bSpline = CreateRef<BSpline>(name + std::to_string(bSplineCount++));
-        m_BSpline.push_back(bSpline);
-        m_BaseObjects.insert(bSpline);
+        Add(bSpline);
         return bSpline;
     }
 
     Ref<InterpolatedCurve> Scene::CreateInterpolated(std::string name)
     {
+        MarkDirty();
         static int interpolatedCount = 0;
         auto interpolated = CreateRef<InterpolatedCurve>(name + std::to_string(interpolatedCount++));
-        m_InterpolatedCurve.push_back(interpolated);
-        m_BaseObjects.insert(interpolated);
+        Add(interpolated);
         return interpolated;
     }
 
     Ref<InterpolatedCurve> Scene::CreateInterpolated(Ref<InterpolatedCurve> curve)
     {
-        for (auto point : curve->GetControlPoints())
-        {
-            m_Points.push_back(point);
-        }
+        MarkDirty();
+        for (const auto& point : curve->TakeCreatedPoints())
+            Add(point);
 
-        m_InterpolatedCurve.push_back(curve);
-        m_BaseObjects.insert(curve);
+        Add(curve);
         return curve;
     }
 
@@ -125,36 +249,33 @@ namespace CADMageddon
 
     Ref<BezierPatch> Scene::CreateBezierPatchRect(std::string name, const PatchRectCreationParameters& parameters)
     {
+        MarkDirty();
         auto bezier = BezierPatch::CreateRectPatch(name + std::to_string(bezierPatchCount++), parameters.Position, parameters.PatchCountX, parameters.PatchCountY, parameters.Width, parameters.Height);
-        for (auto controlPoints : bezier->GetControlPoints())
-        {
-            m_Points.push_back(controlPoints);
-        }
+        for (const auto& point : bezier->TakeCreatedPoints())
+            Add(point);
 
-        m_BezierPatch.push_back(bezier);
-        m_BaseObjects.insert(bezier);
+        Add(bezier);
 
         return bezier;
     }
 
     Ref<BezierPatch> Scene::CreateBezierPatchCylinder(std::string name, const PatchCylinderCreationParameters& parameters)
     {
+        MarkDirty();
         auto bezier = BezierPatch::CreateCyliderPatch(name + std::to_string(bezierPatchCount++), parameters.Center, parameters.PatchCountX, parameters.PatchCountY, parameters.Radius, parameters.Height);
-        for (auto controlPoints : bezier->GetControlPoints())
-        {
-            m_Points.push_back(controlPoints);
-        }
+        for (const auto& point : bezier->TakeCreatedPoints())
+            Add(point);
 
-        m_BezierPatch.push_back(bezier);
-        m_BaseObjects.insert(bezier);
+        Add(bezier);
 
         return bezier;
     }
 
-    Ref<GregoryPatch> Scene::CreateGregoryPatch(Ref<BezierPatch> b1, Ref<BezierPatch> b2, Ref<BezierPatch> b3, Ref<Point> commonPoints[3])
+    Ref<GregoryPatch> Scene::CreateGregoryPatch(Ref<BezierPatch> b1, Ref<BezierPatch> b2, Ref<BezierPatch> b3, PointHandle commonPoints[3])
     {
+        MarkDirty();
         auto gregory = GregoryPatch::Create(b1, b2, b3, commonPoints);
-        m_GregoryPatch.push_back(gregory);
+        Add(gregory);
 
         return gregory;
     }
@@ -163,14 +284,12 @@ namespace CADMageddon
 
     Ref<BSplinePatch> Scene::CreateBSplinePatchRect(std::string name, const PatchRectCreationParameters& parameters)
     {
+        MarkDirty();
         auto bSpline = BSplinePatch::CreateRectPatch(name + std::to_string(bSplinePatchCount++), parameters.Position, parameters.PatchCountX, parameters.PatchCountY, parameters.Width, parameters.Height);
-        for (auto controlPoints : bSpline->GetControlPoints())
-        {
-            m_Points.push_back(controlPoints);
-        }
+        for (const auto& point : bSpline->TakeCreatedPoints())
+            Add(point);
 
-        m_BSplinePatch.push_back(bSpline);
-        m_BaseObjects.insert(bSpline);
+        Add(bSpline);
 
 
         return bSpline;
@@ -178,14 +297,12 @@ namespace CADMageddon
 
     Ref<BSplinePatch> Scene::CreateBSplinePatchCylinder(std::string name, const PatchCylinderCreationParameters& parameters)
     {
+        MarkDirty();
         auto bSpline = BSplinePatch::CreateCyliderPatch(name + std::to_string(bSplinePatchCount++), parameters.Center, parameters.PatchCountX, parameters.PatchCountY, parameters.Radius, parameters.Height);
-        for (auto controlPoints : bSpline->GetControlPoints())
-        {
-            m_Points.push_back(controlPoints);
-        }
+        for (const auto& point : bSpline->TakeCreatedPoints())
+            Add(point);
 
-        m_BSplinePatch.push_back(bSpline);
-        m_BaseObjects.insert(bSpline);
+        Add(bSpline);
 
         return bSpline;
     }
@@ -198,10 +315,10 @@ namespace CADMageddon
         std::vector<IntersectionPoint> intersectionPoints,
         IntersectionType intersectionType)
     {
+        MarkDirty();
         static int intersectionCount = 0;
         auto intersectionCurve = IntersectionCurve::Create("Intersection_" + std::to_string(intersectionCount++), points, s1, s2, intersectionType, intersectionPoints);
-        m_IntersectionCurve.push_back(intersectionCurve);
-
+        Add(intersectionCurve);
 
         if (intersectionType == IntersectionType::ClosedClosed || intersectionType == IntersectionType::ClosedOpen)
         {
@@ -219,136 +336,228 @@ namespace CADMageddon
 
     void Scene::Update()
     {
-        for (auto torus : m_Torus)
-        {
-            RenderTorus(torus);
-        }
+        PropagateChanges();
+        Renderer::SetPointStyle(PointType::Control, m_DefaultColor, m_SelectionColor);
 
-        for (auto bezierC0 : m_BezierC0)
         {
-            if (bezierC0->GetIsVisible())
-                RenderBezier(bezierC0);
+            CDM_PROFILE_SCOPE("Scene::Toruses");
+            m_Registry.view<ObjectComponent<Torus>>().each([this](ObjectComponent<Torus>& torus)
+            {
+                if (Renderer::IsVisible(torus.Object->GetBoundingBox()))
+                    RenderTorus(torus.Object);
+            });
         }
 
-        for (auto bSpline : m_BSpline)
         {
-            if (bSpline->GetIsVisible())
-                RenderBSpline(bSpline);
-        }
+            CDM_PROFILE_SCOPE("Scene::Curves");
+            m_Registry.view<ObjectComponent<BezierC0>, VisibleComponent>().each([this](ObjectComponent<BezierC0>& bezierC0)
+            {
+                if (Renderer::IsVisible(bezierC0.Object->GetBoundingBox()))
+                    RenderBezier(bezierC0.Object);
+            });
 
-        for (auto interpolated : m_InterpolatedCurve)
-        {
-            if (interpolated->GetIsVisible())
-                RenderInterpolatedCurve(interpolated);
-        }
+            m_Registry.view<ObjectComponent<BSpline>, VisibleComponent>().each([this](ObjectComponent<BSpline>& bSpline)
+            {
+                if (Renderer::IsVisible(bSpline.Object->GetBoundingBox()))
+                    RenderBSpline(bSpline.Object);
+            });
 
-        for (auto bezierPatch : m_BezierPatch)
-        {
-            if (bezierPatch->GetIsVisible())
-                RenderBezierPatch(bezierPatch);
+            m_Registry.view<ObjectComponent<InterpolatedCurve>, VisibleComponent>().each([this](ObjectComponent<InterpolatedCurve>& interpolated)
+            {
+                if (Renderer::IsVisible(interpolated.Object->GetBoundingBox()))
+                    RenderInterpolatedCurve(interpolated.Object);
+            });
         }
 
-        for (auto bSplinePatch : m_BSplinePatch)
         {
-            if (bSplinePatch->GetIsVisible())
-                RenderBSplinePatch(bSplinePatch);
+            CDM_PROFILE_SCOPE("Scene::Patches");
+            m_Registry.view<ObjectComponent<BezierPatch>, VisibleComponent>().each([this](ObjectComponent<BezierPatch>& bezierPatch)
+            {
+                if (Renderer::IsVisible(bezierPatch.Object->GetBoundingBox()))
+                    RenderBezierPatch(bezierPatch.Object);
+            });
+
+            m_Registry.view<ObjectComponent<BSplinePatch>, VisibleComponent>().each([this](ObjectComponent<BSplinePatch>& bSplinePatch)
+            {
+                if (Renderer::IsVisible(bSplinePatch.Object->GetBoundingBox()))
+                    RenderBSplinePatch(bSplinePatch.Object);
+            });
         }
 
-        for (auto gregoryPatch : m_GregoryPatch)
         {
-            if (gregoryPatch->GetIsVisible())
-                RenderGregoryPatch(gregoryPatch);
+            CDM_PROFILE_SCOPE("Scene::GregoryPatches");
+            m_Registry.view<ObjectComponent<GregoryPatch>, VisibleComponent>().each([this](ObjectComponent<GregoryPatch>& gregoryPatch)
+            {
+                if (Renderer::IsVisible(gregoryPatch.Object->GetBoundingBox()))
+                    RenderGregoryPatch(gregoryPatch.Object);
+            });
         }
 
-        for (auto intersectionCurve : m_IntersectionCurve)
         {
-            if (intersectionCurve->GetIsVisible())
-                RenderIntersectionCurve(intersectionCurve);
+            CDM_PROFILE_SCOPE("Scene::IntersectionCurves");
+            m_Registry.view<ObjectComponent<IntersectionCurve>, VisibleComponent>().each([this](ObjectComponent<IntersectionCurve>& intersectionCurve)
+            {
+                if (Renderer::IsVisible(intersectionCurve.Object->GetBoundingBox()))
+                    RenderIntersectionCurve(intersectionCurve.Object);
+            });
         }
 
         RenderControlPoints(m_FreePoints);
     }
 
-    void Scene::DeleteSelected()
+    void Scene::RenderPickingIds()
     {
-        std::vector<Ref<Torus>> torusToDelete;
-        std::vector<Ref<BezierC0>> bezierC0ToDelete;
-        std::vector<Ref<BSpline>> bSplineToDelete;
-        std::vector<Ref<InterpolatedCurve>> interpolatedToDelete;
-
-        auto points = m_FreePoints;
-        auto toruses = m_Torus;
-        auto beziers = m_BezierC0;
-        auto splines = m_BSpline;
-        auto interpolatedCurves = m_InterpolatedCurve;
-        auto bezierPatches = m_BezierPatch;
-        auto bSplinePatches = m_BSplinePatch;
-        auto gregoryPatches = m_GregoryPatch;
-        auto intersectionCurves = m_IntersectionCurve;
+        PropagateChanges();
 
-        for (auto point : points)
+        m_Registry.view<ObjectComponent<Torus>>().each([](entt::entity entity, ObjectComponent<Torus>& torus)
         {
-            if (point->GetIsSelected())
-                DeleteFreePoint(point);
-        }
+            if (Renderer::IsVisible(torus.Object->GetBoundingBox()))
+                Renderer::RenderPickingMesh(torus.Object->GetVertexArray(), torus.Object->GetTransform()->GetMatrix(), PickingId::Encode(PickingType::Torus, GetPickingIndex(entity)));
+        });
 
-        for (auto torus : toruses)
+        m_Registry.view<ObjectComponent<BezierC0>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<BezierC0>& bezierC0)
         {
-            if (torus->GetIsSelected())
-                DeleteTorus(torus);
-        }
+            if (!Renderer::IsVisible(bezierC0.Object->GetBoundingBox()))
+                return;
+
+            std::vector<glm::vec3> controlPointsPositions;
+            for (auto point : bezierC0.Object->GetControlPoints())
+                controlPointsPositions.push_back(PointStore::Get().GetPosition(point));
 
-        for (auto bezierC0 : beziers)
+            Renderer::RenderPickingBezier(controlPointsPositions, PickingId::Encode(PickingType::BezierC0, GetPickingIndex(entity)));
+        });
+
+        m_Registry.view<ObjectComponent<BSpline>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<BSpline>& bSpline)
         {
-            if (bezierC0->GetIsSelected())
-                DeleteBezierC0(bezierC0);
-        }
+            if (Renderer::IsVisible(bSpline.Object->GetBoundingBox()))
+                Renderer::RenderPickingBezier(bSpline.Object->GetBezierControlPoints(), PickingId::Encode(PickingType::BSpline, GetPickingIndex(entity)));
+        });
 
-        for (auto bSpline : splines)
+        m_Registry.view<ObjectComponent<InterpolatedCurve>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<InterpolatedCurve>& interpolated)
         {
-            if (bSpline->GetIsSelected())
-                DeleteBSpline(bSpline);
-        }
+            if (Renderer::IsVisible(interpolated.Object->GetBoundingBox()))
+                Renderer::RenderPickingBezier(interpolated.Object->GetBezierControlPoints(), PickingId::Encode(PickingType::InterpolatedCurve, GetPickingIndex(entity)));
+        });
 
-        for (auto interpolated : interpolatedCurves)
+        m_Registry.view<ObjectComponent<BezierPatch>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<BezierPatch>& component)
         {
-            if (interpolated->GetIsSelected())
-                DeleteInterpolatedCurve(interpolated);
-        }
+            auto& bezierPatch = component.Object;
+            if (!Renderer::IsVisible(bezierPatch->GetBoundingBox()))
+                return;
+
+            Renderer::RenderPickingBezierPatch(
+                bezierPatch->GetRenderingVertices(),
+                bezierPatch->GetRenderingIndices(),
+                bezierPatch->GetUDivisionCount(),
+                bezierPatch->GetVDivisionCount(),
+                bezierPatch->GetPatchCountX(),
+                bezierPatch->GetPatchCountY(),
+                bezierPatch->GetIsTrimmed(),
+                bezierPatch->GetTextureId(),
+                bezierPatch->GetReverseTrimming(),
+                PickingId::Encode(PickingType::BezierPatch, GetPickingIndex(entity)));
+        });
 
-        for (auto bezierPatch : bezierPatches)
+        m_Registry.view<ObjectComponent<BSplinePatch>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<BSplinePatch>& component)
         {
-            if (bezierPatch->GetIsSelected())
-                DeleteBezierPatch(bezierPatch);
-        }
+            auto& bSplinePatch = component.Object;
+            if (!Renderer::IsVisible(bSplinePatch->GetBoundingBox()))
+                return;
 
-        for (auto bSplinePatch : bSplinePatches)
+            Renderer::RenderPickingBSplinePatch(
+                bSplinePatch->GetRenderingVertices(),
+                bSplinePatch->GetRenderingIndices(),
+                bSplinePatch->GetUDivisionCount(),
+                bSplinePatch->GetVDivisionCount(),
+                bSplinePatch->GetPatchCountX(),
+                bSplinePatch->GetPatchCountY(),
+                bSplinePatch->GetIsTrimmed(),
+                bSplinePatch->GetTextureId(),
+                bSplinePatch->GetReverseTrimming(),
+                PickingId::Encode(PickingType::BSplinePatch, GetPickingIndex(entity)));
+        });
+
+        m_Registry.view<ObjectComponent<GregoryPatch>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<GregoryPatch>& gregoryPatch)
         {
-            if (bSplinePatch->GetIsSelected())
-                DeleteBSplinePatch(bSplinePatch);
-        }
+            if (!Renderer::IsVisible(gregoryPatch.Object->GetBoundingBox()))
+                return;
 
-        for (auto gregoryPatch : gregoryPatches)
+            //boundary curves of every fill
+            uint32_t id = PickingId::Encode(PickingType::GregoryPatch, GetPickingIndex(entity));
+            for (auto fill : { Fill::B12, Fill::B23, Fill::B31 })
+            {
+                const auto& points = gregoryPatch.Object->GetFillingData(fill).gregoryPoints;
+                Renderer::RenderPickingBezier({ points.p0, points.e0_p, points.e1_m, points.p1, points.e1_p, points.e2_m, points.p2, points.e2_p, points.e3_m, points.p3, points.e3_p, points.e0_m, points.p0 }, id);
+            }
+        });
+
+        m_Registry.view<ObjectComponent<IntersectionCurve>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<IntersectionCurve>& intersectionCurve)
         {
-            if (gregoryPatch->GetIsSelected())
-                DeleteGregoryPatch(gregoryPatch);
-        }
+            if (!Renderer::IsVisible(intersectionCurve.Object->GetBoundingBox()))
+                return;
+
+            uint32_t id = PickingId::Encode(PickingType::IntersectionCurve, GetPickingIndex(entity));
+            const auto& points = intersectionCurve.Object->GetIntersectionPoints();
+            for (int j = 1; j < points.size(); j++)
+                Renderer::RenderPickingLine(points[j - 1].Location, points[j].Location, id);
+        });
 
-        for (auto intersected : intersectionCurves)
+        if (!Renderer::ShowPoints)
+            return;
+
+        m_Registry.view<ObjectComponent<Point>, VisibleComponent>().each([](entt::entity entity, ObjectComponent<Point>& point)
         {
-            if (intersected->GetIsSelected())
-                DeleteIntersectionCurve(intersected);
-        }
+            Renderer::RenderPickingPoint(point.Object->GetPosition(), PickingId::Encode(PickingType::Point, GetPickingIndex(entity)));
+        });
+    }
+
+    void Scene::ClearSelection()
+    {
+        ClearSelectionOf<Point, Torus, BezierC0, BSpline, InterpolatedCurve, BezierPatch, BSplinePatch, GregoryPatch, IntersectionCurve>();
+    }
+
+    void Scene::DeleteSelected()
+    {
+        MarkDirty();
+
+        //collected up front, deleting changes the pools and frees the points of deleted objects
+        std::vector<Ref<Point>> points;
+        ForEachSelected<Point>([this, &points](const Ref<Point>& point)
+        {
+            if (GetOwnerCount(point) == 0)
+                points.push_back(point);
+        });
+
+        auto toruses = GetSelected<Torus>();
+        auto beziers = GetSelected<BezierC0>();
+        auto splines = GetSelected<BSpline>();
+        auto interpolatedCurves = GetSelected<InterpolatedCurve>();
+        auto bezierPatches = GetSelected<BezierPatch>();
+        auto bSplinePatches = GetSelected<BSplinePatch>();
+        auto gregoryPatches = GetSelected<GregoryPatch>();
+        auto intersectionCurves = GetSelected<IntersectionCurve>();
+
+        DeleteObjects(points, m_Points, m_FreePoints);
+        DeleteObjects(toruses, m_Torus);
+        DeleteObjects(beziers, m_BezierC0);
+        DeleteObjects(splines, m_BSpline);
+        DeleteObjects(interpolatedCurves, m_InterpolatedCurve);
+        DeleteBezierPatches(bezierPatches);
+        DeleteObjects(bSplinePatches, m_BSplinePatch);
+        //the ones built from deleted patches are already gone, unregistering skips them
+        DeleteObjects(gregoryPatches, m_GregoryPatch);
+        DeleteIntersectionCurves(intersectionCurves);
     }
 
     void Scene::AssignSelectedFreeToBezier(Ref<BezierC0> bezier)
     {
+        MarkDirty();
         auto points = m_FreePoints;
         for (auto point : points)
         {
             if (point->GetIsSelected())
             {
-                bezier->AddControlPoint(point);
+                AddControlPoint(bezier, point);
                 auto it = std::find(m_FreePoints.begin(), m_FreePoints.end(), point);
                 m_FreePoints.erase(it);
             }
@@ -357,12 +566,13 @@ namespace CADMageddon
 
     void Scene::AssignSelectedFreeToBSpline(Ref<BSpline> bSpline)
     {
+        MarkDirty();
         auto points = m_FreePoints;
         for (auto point : points)
         {
             if (point->GetIsSelected())
             {
-                bSpline->AddControlPoint(point);
+                AddControlPoint(bSpline, point);
                 auto it = std::find(m_FreePoints.begin(), m_FreePoints.end(), point);
                 m_FreePoints.erase(it);
             }
@@ -371,12 +581,13 @@ namespace CADMageddon
 
     void Scene::AssignSelectedFreeToInterpolated(Ref<InterpolatedCurve> interpolatedCurve)
     {
+        MarkDirty();
         auto points = m_FreePoints;
         for (auto point : points)
         {
             if (point->GetIsSelected())
             {
-                interpolatedCurve->AddControlPoint(point);
+                AddControlPoint(interpolatedCurve, point);
                 auto it = std::find(m_FreePoints.begin(), m_FreePoints.end(), point);
                 m_FreePoints.erase(it);
             }
@@ -385,23 +596,20 @@ namespace CADMageddon
 
     void Scene::RemovePointFromBezier(Ref<BezierC0> bezier, Ref<Point> point)
     {
-        bezier->RemoveControlPoint(point);
-        if (point->GetReferencedCount() == 0)
-            m_FreePoints.push_back(point);
+        MarkDirty();
+        RemoveControlPoint(bezier, point);
     }
 
     void Scene::RemovePointFromBSpline(Ref<BSpline> bSpline, Ref<Point> point)
     {
-        bSpline->RemoveControlPoint(point);
-        if (point->GetReferencedCount() == 0)
-            m_FreePoints.push_back(point);
+        MarkDirty();
+        RemoveControlPoint(bSpline, point);
     }
 
     void Scene::RemovePointFromInterpolated(Ref<InterpolatedCurve> interpolatedCurve, Ref<Point> point)
     {
-        interpolatedCurve->RemoveControlPoint(point);
-        if (point->GetReferencedCount() == 0)
-            m_FreePoints.push_back(point);
+        MarkDirty();
+        RemoveControlPoint(interpolatedCurve, point);
     }
 
     bool Scene::AddNewPointToBezier(Ref<Point> point)
@@ -412,7 +620,7 @@ namespace CADMageddon
             if (bezier->GetIsSelected())
             {
                 added = true;
-                bezier->AddControlPoint(point);
+                AddControlPoint(bezier, point);
                 return true;
             }
         }
@@ -429,7 +637,7 @@ namespace CADMageddon
             if (bSpline->GetIsSelected())
             {
                 added = true;
-                bSpline->AddControlPoint(point);
+                AddControlPoint(bSpline, point);
                 return true;
             }
         }
@@ -446,7 +654,7 @@ namespace CADMageddon
             if (interpolated->GetIsSelected())
             {
                 added = true;
-                interpolated->AddControlPoint(point);
+                AddControlPoint(interpolated, point);
                 return true;
             }
         }
@@ -454,33 +662,33 @@ namespace CADMageddon
         return added;
     }
 
-    void Scene::RenderControlPoints(const std::vector<Ref<Point>>& points)
+    void Scene::RenderControlPoints(const std::vector<PointHandle>& points)
     {
+        auto& store = PointStore::Get();
         for (auto point : points)
         {
-            auto color = point->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
-            if (point->GetIsVisible())
-                Renderer::RenderPoint(point->GetPosition(), color);
+            auto state = PackPointState(PointType::Control, store.HasFlag(point, PointFlagSelected), store.HasFlag(point, PointFlagVisible));
+            Renderer::RenderPoint(store.GetPosition(point), state);
         }
     }
 
-    void Scene::RenderControlPoints(const std::vector<glm::vec3>& points, const glm::vec4& color)
+    void Scene::RenderControlPoints(const std::vector<glm::vec3>& points)
     {
-        for (auto point : points)
-        {
-            Renderer::RenderPoint(point, color);
-        }
+        uint8_t state = PackPointState(PointType::Virtual);
+        for (const auto& point : points)
+            Renderer::RenderPoint(point, state);
     }
 
-    void Scene::RenderControlPolygon(const std::vector<Ref<Point>>& points, const glm::vec4& color)
+    void Scene::RenderControlPolygon(const std::vector<PointHandle>& points, const glm::vec4& color)
     {
         if (points.empty())
             return;
 
+        auto& store = PointStore::Get();
         for (int i = 1; i < points.size(); i++)
         {
-            auto start = points[i - 1]->GetPosition();
-            auto end = points[i]->GetPosition();
+            auto start = store.GetPosition(points[i - 1]);
+            auto end = store.GetPosition(points[i]);
             Renderer::RenderLine(start, end, color);
         }
     }
@@ -498,38 +706,30 @@ namespace CADMageddon
         }
     }
 
-    void Scene::RenderControlGrid(const std::vector<Ref<Point>>& points, const std::vector<uint32_t>& gridIndices, const glm::vec4& color)
+    void Scene::RenderControlGrid(const std::vector<PointHandle>& points, const std::vector<uint32_t>& gridIndices, const glm::vec4& color)
     {
+        auto& store = PointStore::Get();
         for (int i = 0; i < gridIndices.size() - 1; i += 2)
         {
             auto color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
-            Renderer::RenderLine(points[gridIndices[i]]->GetPosition(), points[gridIndices[i + 1]]->GetPosition(), color);
+            Renderer::RenderLine(store.GetPosition(points[gridIndices[i]]), store.GetPosition(points[gridIndices[i + 1]]), color);
         }
     }
 
     void Scene::RenderTorus(Ref<Torus> torus)
     {
-
-        std::vector<glm::vec3> vertices;
-        for (auto point : torus->GetPoints())
-        {
-            vertices.push_back(point->GetTransform()->Translation);
-        }
-
         auto color = torus->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
 
         if (!torus->GetIsTrimmed())
         {
-            Renderer::RenderTorus(vertices, torus->GetTextureCoordinates(), torus->GetIndices(), torus->GetTransform()->GetMatrix(), color);
+            Renderer::RenderTorus(torus->GetVertexArray(), torus->GetTransform()->GetMatrix(), color);
         }
         else
         {
             Renderer::RenderTrimmedTorus(
-                vertices,
-                torus->GetTextureCoordinates(),
+                torus->GetVertexArray(),
                 torus->GetReverseTrimming(),
                 torus->GetTextureId(),
-                torus->GetIndices(),
                 torus->GetTransform()->GetMatrix(),
                 color);
         }
@@ -537,12 +737,12 @@ namespace CADMageddon
 
     void Scene::RenderBezier(Ref<BezierC0> bezierC0)
     {
-        auto controlPoints = bezierC0->GetControlPoints();
+        const auto& controlPoints = bezierC0->GetControlPoints();
         if (controlPoints.empty())
             return;
 
         std::vector<glm::vec3> controlPointsPositions;
-        std::transform(controlPoints.begin(), controlPoints.end(), std::back_inserter(controlPointsPositions), [](Ref<Point> p) {return p->GetPosition(); });
+        std::transform(controlPoints.begin(), controlPoints.end(), std::back_inserter(controlPointsPositions), [](PointHandle p) {return PointStore::Get().GetPosition(p); });
 
         RenderControlPoints(controlPoints);
 
@@ -557,8 +757,8 @@ namespace CADMageddon
 
     void Scene::RenderBSpline(Ref<BSpline> bSpline)
     {
-        auto controlPoints = bSpline->GetControlPoints();
-        auto bezierPoints = bSpline->GetBezierControlPoints();
+        const auto& controlPoints = bSpline->GetControlPoints();
+        const auto& bezierPoints = bSpline->GetBezierControlPoints();
         if (bezierPoints.empty())
         {
             RenderControlPoints(controlPoints);
@@ -588,8 +788,8 @@ namespace CADMageddon
 
     void Scene::RenderInterpolatedCurve(Ref<InterpolatedCurve> interPolatedCurve)
     {
-        auto controlPoints = interPolatedCurve->GetControlPoints();
-        auto bezierPoints = interPolatedCurve->GetBezierControlPoints();
+        const auto& controlPoints = interPolatedCurve->GetControlPoints();
+        const auto& bezierPoints = interPolatedCurve->GetBezierControlPoints();
         auto interpolatedColor = interPolatedCurve->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
 
         RenderControlPoints(controlPoints);
@@ -603,10 +803,10 @@ namespace CADMageddon
 
     void Scene::RenderBezierPatch(Ref<BezierPatch> bezierPatch)
     {
-        auto indices = bezierPatch->GetRenderingIndices();
-        auto controlPoints = bezierPatch->GetControlPoints();
-        auto vertices = bezierPatch->GetRenderingVertices();
-        auto textureCooridnates = bezierPatch->GetTextureCoordinates();
+        const auto& indices = bezierPatch->GetRenderingIndices();
+        const auto& controlPoints = bezierPatch->GetControlPoints();
+        const auto& vertices = bezierPatch->GetRenderingVertices();
+        const auto& textureCooridnates = bezierPatch->GetTextureCoordinates();
         auto color = bezierPatch->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
 
 
@@ -633,10 +833,10 @@ namespace CADMageddon
 
     void Scene::RenderBSplinePatch(Ref<BSplinePatch> bSplinePatch)
     {
-        auto indices = bSplinePatch->GetRenderingIndices();
-        auto controlPoints = bSplinePatch->GetControlPoints();
-        auto vertices = bSplinePatch->GetRenderingVertices();
-        auto textureCooridnates = bSplinePatch->GetTextureCoordinates();
+        const auto& indices = bSplinePatch->GetRenderingIndices();
+        const auto& controlPoints = bSplinePatch->GetControlPoints();
+        const auto& vertices = bSplinePatch->GetRenderingVertices();
+        const auto& textureCooridnates = bSplinePatch->GetTextureCoordinates();
         auto color = bSplinePatch->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
 
         Renderer::RenderBSplinePatch(
@@ -663,66 +863,41 @@ namespace CADMageddon
     void Scene::RenderGregoryPatch(Ref<GregoryPatch> gregoryPatch)
     {
         auto color = gregoryPatch->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
-        int uDivisionCount = gregoryPatch->GetUDivisionCount();
-        int vDivisionCount = gregoryPatch->GetVDivisionCount();
         glm::vec4 blue = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
 
-        if (gregoryPatch->GetShowFirst() || gregoryPatch->GetShowFirstMesh())
+        std::pair<bool, bool> visibility[3] =
         {
-            auto fillingData = gregoryPatch->GetFillingData(Fill::B12);
-            if (gregoryPatch->GetShowFirst())
-                RenderGregoryPatch(fillingData, uDivisionCount, vDivisionCount, gregoryPatch->GetShowFirstMesh(), color);
-            if (gregoryPatch->GetShowFirstMesh())
-                RenderGregoryPatchMesh(fillingData, blue);
+            { gregoryPatch->GetShowFirst(), gregoryPatch->GetShowFirstMesh() },
+            { gregoryPatch->GetShowSecond(), gregoryPatch->GetShowSecondMesh() },
+            { gregoryPatch->GetShowThird(), gregoryPatch->GetShowThirdMesh() }
+        };
+        Fill fills[3] = { Fill::B12, Fill::B23, Fill::B31 };
 
-        }
-        if (gregoryPatch->GetShowSecond() || gregoryPatch->GetShowSecondMesh())
+        GregoryPoints patches[3];
+        int patchCount = 0;
+        for (int i = 0; i < 3; i++)
         {
-            auto fillingData = gregoryPatch->GetFillingData(Fill::B23);
-            if (gregoryPatch->GetShowSecond())
-                RenderGregoryPatch(fillingData, uDivisionCount, vDivisionCount, gregoryPatch->GetShowFirstMesh(), color);
-            if (gregoryPatch->GetShowSecondMesh())
-                RenderGregoryPatchMesh(fillingData, blue);
-        }
-        if (gregoryPatch->GetShowThird() || gregoryPatch->GetShowThirdMesh())
-        {
-            auto fillingData = gregoryPatch->GetFillingData(Fill::B31);
-            if (gregoryPatch->GetShowThird())
-                RenderGregoryPatch(fillingData, uDivisionCount, vDivisionCount, gregoryPatch->GetShowFirstMesh(), color);
-            if (gregoryPatch->GetShowThirdMesh())
+            auto [showFill, showMesh] = visibility[i];
+            if (!showFill && !showMesh)
+                continue;
+
+            const auto& fillingData = gregoryPatch->GetFillingData(fills[i]);
+            if (showFill)
+                patches[patchCount++] = fillingData.gregoryPoints;
+            if (showMesh)
                 RenderGregoryPatchMesh(fillingData, blue);
         }
-    }
 
-    void Scene::RenderGregoryPatch(FillingData fillingData, int uDivisionCount, int vDivisionCount, bool showMesh, const glm::vec4& color)
-    {
-        Renderer::RenderGregoryPatch(
-            fillingData.gregoryPoints.p0,
-            fillingData.gregoryPoints.e0_m,
-            fillingData.gregoryPoints.e0_p,
-            fillingData.gregoryPoints.f0_m,
-            fillingData.gregoryPoints.f0_p,
-            fillingData.gregoryPoints.p1,
-            fillingData.gregoryPoints.e1_m,
-            fillingData.gregoryPoints.e1_p,
-            fillingData.gregoryPoints.f1_m,
-            fillingData.gregoryPoints.f1_p,
-            fillingData.gregoryPoints.p2,
-            fillingData.gregoryPoints.e2_m,
-            fillingData.gregoryPoints.e2_p,
-            fillingData.gregoryPoints.f2_m,
-            fillingData.gregoryPoints.f2_p,
-            fillingData.gregoryPoints.p3,
-            fillingData.gregoryPoints.e3_m,
-            fillingData.gregoryPoints.e3_p,
-            fillingData.gregoryPoints.f3_m,
-            fillingData.gregoryPoints.f3_p,
-            uDivisionCount,
-            vDivisionCount,
+        //GregoryPoints is 20 consecutive vec3, the visible fills go to the renderer as one block
+        Renderer::RenderGregoryPatches(
+            reinterpret_cast<const glm::vec3*>(patches),
+            patchCount,
+            gregoryPatch->GetUDivisionCount(),
+            gregoryPatch->GetVDivisionCount(),
             color);
     }
 
-    void Scene::RenderGregoryPatchMesh(FillingData fillingData, const glm::vec4& color)
+    void Scene::RenderGregoryPatchMesh(const FillingData& fillingData, const glm::vec4& color)
     {
         Renderer::RenderLine(fillingData.gregoryPoints.p0, fillingData.gregoryPoints.e0_m, color);
         Renderer::RenderLine(fillingData.gregoryPoints.p0, fillingData.gregoryPoints.e0_p, color);
@@ -755,173 +930,53 @@ namespace CADMageddon
 
     void Scene::RenderIntersectionCurve(Ref<IntersectionCurve> curve)
     {
-        auto points = curve->GetIntersectionPoints();
-        auto color = curve->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
-        for (int i = 1; i < points.size(); i++)
-        {
-            auto start = points[i - 1];
-            auto end = points[i];
-            Renderer::RenderLine(start.Location, end.Location, color);
-        }
-    }
-
-    void Scene::DeleteFreePoint(Ref<Point> point)
-    {
-        {
-            auto it = std::find(m_Points.begin(), m_Points.end(), point);
-            if (it != m_Points.end())
-            {
-                m_Points.erase(it);
-            }
-        }
-        {
-            auto it = std::find(m_FreePoints.begin(), m_FreePoints.end(), point);
-            if (it != m_FreePoints.end())
-            {
-                m_FreePoints.erase(it);
-            }
-        }
-    }
-
-    void Scene::DeleteTorus(Ref<Torus> torus)
-    {
-        auto it = std::find(m_Torus.begin(), m_Torus.end(), torus);
-        if (it != m_Torus.end())
-        {
-            m_Torus.erase(it);
-        }
-    }
-
-    void Scene::DeleteBezierC0(Ref<BezierC0> bezierC0)
-    {
-        auto it = std::find(m_BezierC0.begin(), m_BezierC0.end(), bezierC0);
-        if (it != m_BezierC0.end())
-        {
-            for (auto point : bezierC0->GetControlPoints())
-            {
-                int pointReferenceCount = point->GetReferencedCount();
-                point->SetReferencedCount(pointReferenceCount - 1);
-
-                if (pointReferenceCount == 1)
-                    m_FreePoints.push_back(point);
-            }
-
-            m_BezierC0.erase(it);
-        }
-
-        m_BaseObjects.erase(bezierC0);
-    }
-
-    void Scene::DeleteBSpline(Ref<BSpline> bSpline)
-    {
-        auto it = std::find(m_BSpline.begin(), m_BSpline.end(), bSpline);
-        if (it != m_BSpline.end())
-        {
-            for (auto point : bSpline->GetControlPoints())
-            {
-                int pointReferenceCount = point->GetReferencedCount();
-                point->SetReferencedCount(pointReferenceCount - 1);
-
-                if (pointReferenceCount == 1)
-                    m_FreePoints.push_back(point);
-            }
-
-            m_BSpline.erase(it);
-        }
-
-        m_BaseObjects.erase(bSpline);
-
-    }
-
-    void Scene::DeleteInterpolatedCurve(Ref<InterpolatedCurve> interpolatedCurve)
-    {
-        auto it = std::find(m_InterpolatedCurve.begin(), m_InterpolatedCurve.end(), interpolatedCurve);
-        if (it != m_InterpolatedCurve.end())
-        {
-            for (auto point : interpolatedCurve->GetControlPoints())
-            {
-                int pointReferenceCount = point->GetReferencedCount();
-                point->SetReferencedCount(pointReferenceCount - 1);
-
-                if (pointReferenceCount == 1)
-                    m_FreePoints.push_back(point);
-            }
-
-            m_InterpolatedCurve.erase(it);
-        }
-
-        m_BaseObjects.erase(interpolatedCurve);
+        if (!curve->GetLineVertexArray())
+            return;
 
+        auto color = curve->GetIsSelected() ? m_SelectionColor : m_DefaultColor;
+        Renderer::RenderLineStrip(curve->GetLineVertexArray(), curve->GetIntersectionPoints().size(), color);
     }
 
-    void Scene::DeleteBezierPatch(Ref<BezierPatch> bezierPatch)
+    void Scene::DeleteBezierPatches(const std::vector<Ref<BezierPatch>>& bezierPatches)
     {
-        auto it = std::find(m_BezierPatch.begin(), m_BezierPatch.end(), bezierPatch);
-        if (it != m_BezierPatch.end())
-        {
-            for (auto point : bezierPatch->GetControlPoints())
-            {
-                int pointReferenceCount = point->GetReferencedCount();
-                point->SetReferencedCount(pointReferenceCount - 1);
-
-                if (pointReferenceCount == 1)
-                    m_FreePoints.push_back(point);
-            }
-
-            m_BezierPatch.erase(it);
-        }
+        MarkDirty();
 
-        m_BaseObjects.erase(bezierPatch);
-        auto gregoryPatches = m_GregoryPatch;
-
-        for (auto gregory : gregoryPatches)
+        //Gregory patches built from the patches go with them
+        std::vector<Ref<GregoryPatch>> gregoryPatches;
+        for (const auto& bezierPatch : bezierPatches)
         {
-            if (gregory->GetB1() == bezierPatch || gregory->GetB2() == bezierPatch || gregory->GetB3() == bezierPatch)
+            auto [begin, end] = m_Dependents.equal_range(bezierPatch->GetEntity().GetHandle());
+            for (auto dependent = begin; dependent != end; ++dependent)
             {
-                auto it = std::find(m_GregoryPatch.begin(), m_GregoryPatch.end(), gregory);
-                if (it != m_GregoryPatch.end())
-                    m_GregoryPatch.erase(it);
-                if (m_OnGregoryPatchDeleted)
-                    m_OnGregoryPatchDeleted(gregory);
+                if (auto gregory = m_Registry.try_get<ObjectComponent<GregoryPatch>>(dependent->second))
+                {
+                    //a hole between two deleted patches is listed by both
+                    if (!m_Registry.has<DeletedComponent>(dependent->second))
+                        gregoryPatches.push_back(gregory->Object);
+                    gregory->Object->GetEntity().SetTag<DeletedComponent>(true);
+                }
             }
         }
-    }
-
-    void Scene::DeleteGregoryPatch(Ref<GregoryPatch> gregoryPatch)
-    {
-        auto it = std::find(m_GregoryPatch.begin(), m_GregoryPatch.end(), gregoryPatch);
-        if (it != m_GregoryPatch.end())
-            m_GregoryPatch.erase(it);
-    }
 
-    void Scene::DeleteBSplinePatch(Ref<BSplinePatch> bSplinePatch)
-    {
-        auto it = std::find(m_BSplinePatch.begin(), m_BSplinePatch.end(), bSplinePatch);
-        if (it != m_BSplinePatch.end())
+        DeleteObjects(gregoryPatches, m_GregoryPatch);
+        if (m_OnGregoryPatchDeleted)
         {
-            for (auto point : bSplinePatch->GetControlPoints())
-            {
-                int pointReferenceCount = point->GetReferencedCount();
-                point->SetReferencedCount(pointReferenceCount - 1);
-
-                if (pointReferenceCount == 1)
-                    m_FreePoints.push_back(point);
-            }
-
-            m_BSplinePatch.erase(it);
+            for (const auto& gregory : gregoryPatches)
+                m_OnGregoryPatchDeleted(gregory);
         }
 
-        m_BaseObjects.erase(bSplinePatch);
+        DeleteObjects(bezierPatches, m_BezierPatch);
     }
 
-    void Scene::DeleteIntersectionCurve(Ref<IntersectionCurve> curve)
+    void Scene::DeleteIntersectionCurves(const std::vector<Ref<IntersectionCurve>>& curves)
     {
-        auto it = std::find(m_IntersectionCurve.begin(), m_IntersectionCurve.end(), curve);
-        if (it != m_IntersectionCurve.end())
+        MarkDirty();
+        for (const auto& curve : curves)
         {
-            m_IntersectionCurve.erase(it);
             curve->GetFirstSurface()->SetIntersectionCurve(nullptr);
             curve->GetSecondSurface()->SetIntersectionCurve(nullptr);
         }
+
+        DeleteObjects(curves, m_IntersectionCurve);
     }
 }
\ No newline at end of file
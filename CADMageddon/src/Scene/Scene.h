@@ -9,6 +9,8 @@
 #include "BSplinePatch.h"
 #include "GregoryPatch.h"
 #include "IntersectionCurve.h"
+#include "PickingId.h"
+#include "Components.h"
 
 namespace CADMageddon
 {
@@ -36,7 +38,9 @@ namespace CADMageddon
     {
     public:
         Scene();
+        ~Scene();
         void Update();
+        void RenderPickingIds();
         void DeleteSelected();
         void AssignSelectedFreeToBezier(Ref<BezierC0> bezier);
         void AssignSelectedFreeToBSpline(Ref<BSpline> bSpline);
@@ -51,6 +55,29 @@ namespace CADMageddon
 
         void MergePoints(Ref<Point> p1, Ref<Point> p2);
 
+        //number of objects using the point, free points have none
+        int GetOwnerCount(const Ref<Point>& point) const { return (int)m_PointOwners.count(point->GetHandle()); }
+
+        // The selection set is the SelectedComponent pool, a sparse set with a dense list of the selected
+        // entities. Objects keep their own flag and mirror it there, so selecting still goes through
+        // SetIsSelected, but clearing and walking the selection never touch unselected objects.
+        void ClearSelection();
+
+        template<typename... T>
+        void ClearSelectionOf()
+        {
+            (DeselectAll<T>(), ...);
+        }
+
+        //calls function(const Ref<T>&) for every selected object of type T
+        template<typename T, typename Function>
+        void ForEachSelected(Function function)
+        {
+            m_Registry.view<ObjectComponent<T>, SelectedComponent>().each([&function](ObjectComponent<T>& component) { function(component.Object); });
+        }
+
+        std::size_t GetSelectedCount() const { return m_Registry.size<SelectedComponent>(); }
+
 
 
         Ref<Point> CreatePoint(glm::vec3 position, std::string name);
@@ -63,7 +90,7 @@ namespace CADMageddon
 
         Ref<BezierPatch> CreateBezierPatchRect(std::string name, const PatchRectCreationParameters& parameters);
         Ref<BezierPatch> CreateBezierPatchCylinder(std::string name, const PatchCylinderCreationParameters& parameters);
-        Ref<GregoryPatch> CreateGregoryPatch(Ref<BezierPatch> b1, Ref<BezierPatch> b2, Ref<BezierPatch> b3, Ref<Point> commontPoinst[3]);
+        Ref<GregoryPatch> CreateGregoryPatch(Ref<BezierPatch> b1, Ref<BezierPatch> b2, Ref<BezierPatch> b3, PointHandle commonPoints[3]);
 
         Ref<BSplinePatch> CreateBSplinePatchRect(std::string name, const PatchRectCreationParameters& parameters);
         Ref<BSplinePatch> CreateBSplinePatchCylinder(std::string name, const PatchCylinderCreationParameters& parameters);
@@ -76,16 +103,28 @@ namespace CADMageddon
             std::vector<IntersectionPoint> intersectionPoints,
             IntersectionType intersectionType);
 
-        std::vector<Ref<Point>> GetFreePoints() const { return m_FreePoints; }
-        std::vector<Ref<Point>> GetPoints() const { return m_Points; }
-        std::vector<Ref<Torus>> GetTorus() const { return m_Torus; }
-        std::vector<Ref<BezierC0>> GetBezierC0() const { return m_BezierC0; }
-        std::vector<Ref<BSpline>> GetBSpline() const { return m_BSpline; }
-        std::vector<Ref<InterpolatedCurve>> GetInterpolated() const { return m_InterpolatedCurve; }
-        std::vector<Ref<BezierPatch>> GetBezierPatch() const { return m_BezierPatch; }
-        std::vector<Ref<BSplinePatch>> GetBSplinePatch() const { return m_BSplinePatch; }
-        std::vector<Ref<GregoryPatch>> GetGregoryPatch() const { return m_GregoryPatch; }
-        std::vector<Ref<IntersectionCurve>>  GetIntersectionCurve() const { return m_IntersectionCurve; }
+        const std::vector<Ref<Point>>& GetFreePoints() const { return m_FreePoints; }
+        const std::vector<Ref<Point>>& GetPoints() const { return m_Points; }
+        const std::vector<Ref<Torus>>& GetTorus() const { return m_Torus; }
+        const std::vector<Ref<BezierC0>>& GetBezierC0() const { return m_BezierC0; }
+        const std::vector<Ref<BSpline>>& GetBSpline() const { return m_BSpline; }
+        const std::vector<Ref<InterpolatedCurve>>& GetInterpolated() const { return m_InterpolatedCurve; }
+        const std::vector<Ref<BezierPatch>>& GetBezierPatch() const { return m_BezierPatch; }
+        const std::vector<Ref<BSplinePatch>>& GetBSplinePatch() const { return m_BSplinePatch; }
+        const std::vector<Ref<GregoryPatch>>& GetGregoryPatch() const { return m_GregoryPatch; }
+        const std::vector<Ref<IntersectionCurve>>& GetIntersectionCurve() const { return m_IntersectionCurve; }
+
+        //object behind an index written by RenderPickingIds, null if it was deleted since or is of another type
+        template<typename T>
+        Ref<T> GetPickedObject(uint32_t pickingIndex) const
+        {
+            auto entity = GetEntityByPickingIndex(pickingIndex);
+            if (entity == entt::null)
+                return nullptr;
+
+            auto component = m_Registry.try_get<ObjectComponent<T>>(entity);
+            return component ? component->Object : nullptr;
+        }
 
         void SetOnPointMerged(std::function<void(Ref<Point> p1, Ref<Point> p2, Ref<Point> p3)> onPointMergedCallback)
         {
@@ -97,13 +136,186 @@ namespace CADMageddon
             m_OnGregoryPatchDeleted = gregoryPatchDeletedCallback;
         }
 
+        void SetOnChanged(std::function<void()> changedCallback)
+        {
+            m_OnChanged = changedCallback;
+        }
+
+        //objects are added, removed or reconnected, the editor has to render a new frame
+        void MarkDirty()
+        {
+            if (m_OnChanged)
+                m_OnChanged();
+        }
+
     private:
-        void RenderControlPoints(const std::vector<Ref<Point>>& points);
-        void RenderControlPoints(const std::vector<glm::vec3>& points, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0, 1.0f));
-        void RenderControlPolygon(const std::vector<Ref<Point>>& points, const glm::vec4& color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+        //the only way an object enters the scene, its container keeps the creation order and the registry the rest
+        template<typename T>
+        void Add(const Ref<T>& object)
+        {
+            GetObjects<T>().push_back(object);
+            Register(object);
+        }
+
+        template<typename T>
+        std::vector<Ref<T>>& GetObjects()
+        {
+            if constexpr (std::is_same_v<T, Point>)
+                return m_Points;
+            else if constexpr (std::is_same_v<T, Torus>)
+                return m_Torus;
+            else if constexpr (std::is_same_v<T, BezierC0>)
+                return m_BezierC0;
+            else if constexpr (std::is_same_v<T, BSpline>)
+                return m_BSpline;
+            else if constexpr (std::is_same_v<T, InterpolatedCurve>)
+                return m_InterpolatedCurve;
+            else if constexpr (std::is_same_v<T, BezierPatch>)
+                return m_BezierPatch;
+            else if constexpr (std::is_same_v<T, BSplinePatch>)
+                return m_BSplinePatch;
+            else if constexpr (std::is_same_v<T, GregoryPatch>)
+                return m_GregoryPatch;
+            else
+            {
+                static_assert(std::is_same_v<T, IntersectionCurve>, "not a scene object type");
+                return m_IntersectionCurve;
+            }
+        }
+
+        //every scene object gets an entity, the components point back at the object
+        template<typename T>
+        void Register(const Ref<T>& object)
+        {
+            auto entity = m_Registry.create();
+            m_Registry.emplace<ObjectComponent<T>>(entity, object);
+            object->GetEntity().Attach(&m_Registry, entity);
+
+            if constexpr (std::is_base_of_v<BaseObject, T>)
+            {
+                m_Registry.emplace<ControlPointRefsComponent>(entity, &object->GetControlPoints());
+                m_Registry.emplace<DerivedDataComponent>(entity, object.get());
+                for (auto point : object->GetControlPoints())
+                    AddOwner(point, entity);
+            }
+
+            if constexpr (std::is_same_v<T, GregoryPatch>)
+            {
+                for (const auto& patch : { object->GetB1(), object->GetB2(), object->GetB3() })
+                {
+                    if (patch->GetEntity().IsAttachedTo(m_Registry))
+                        AddDependent(patch->GetEntity().GetHandle(), entity);
+                }
+            }
+
+            //toruses cannot be hidden
+            bool isVisible = true;
+            if constexpr (!std::is_same_v<T, Torus>)
+                isVisible = object->GetIsVisible();
+
+            object->GetEntity().template SetTag<SelectedComponent>(object->GetIsSelected());
+            object->GetEntity().template SetTag<VisibleComponent>(isVisible);
+        }
+
+        template<typename T>
+        void Unregister(const Ref<T>& object)
+        {
+            auto& entity = object->GetEntity();
+            if (!entity.IsAttachedTo(m_Registry))
+                return;
+
+            if constexpr (std::is_base_of_v<BaseObject, T>)
+                ReleaseControlPoints(entity.GetHandle(), object->GetControlPoints());
+
+            if constexpr (std::is_same_v<T, GregoryPatch>)
+            {
+                for (const auto& patch : { object->GetB1(), object->GetB2(), object->GetB3() })
+                    RemoveDependent(patch->GetEntity().GetHandle(), entity.GetHandle());
+            }
+
+            m_Dependents.erase(entity.GetHandle());
+            m_Registry.destroy(entity.GetHandle());
+            entity.Detach();
+        }
+
+        //deselecting removes the tag, the view allows removing the current entity while iterating
+        template<typename T>
+        void DeselectAll()
+        {
+            m_Registry.view<ObjectComponent<T>, SelectedComponent>().each([](ObjectComponent<T>& component) { component.Object->SetIsSelected(false); });
+        }
+
+        template<typename T>
+        std::vector<Ref<T>> GetSelected()
+        {
+            std::vector<Ref<T>> selected;
+            ForEachSelected<T>([&selected](const Ref<T>& object) { selected.push_back(object); });
+            return selected;
+        }
+
+        // Batch delete, the victims are tagged first so every container they are in is compacted in
+        // one stable pass instead of a find and erase per victim. Unregistering releases the control
+        // points, the ones nothing uses anymore are appended to the free points.
+        template<typename T, typename... Containers>
+        void DeleteObjects(const std::vector<Ref<T>>& objects, Containers&... containers)
+        {
+            if (objects.empty())
+                return;
+
+            for (const auto& object : objects)
+                object->GetEntity().template SetTag<DeletedComponent>(true);
+
+            (EraseMarked(containers), ...);
+
+            for (const auto& object : objects)
+                Unregister(object);
+        }
+
+        template<typename T>
+        void EraseMarked(std::vector<Ref<T>>& objects)
+        {
+            auto isMarked = [this](const Ref<T>& object)
+            {
+                auto& entity = object->GetEntity();
+                return entity.IsAttachedTo(m_Registry) && m_Registry.has<DeletedComponent>(entity.GetHandle());
+            };
+
+            objects.erase(std::remove_if(objects.begin(), objects.end(), isMarked), objects.end());
+        }
+
+        //objects can outlive the scene, their links must not point into the destroyed registry
+        template<typename T>
+        void DetachAll()
+        {
+            m_Registry.view<ObjectComponent<T>>().each([](ObjectComponent<T>& component) { component.Object->GetEntity().Detach(); });
+        }
+
+        entt::entity GetEntityByPickingIndex(uint32_t pickingIndex) const;
+
+        void AddOwner(PointHandle point, entt::entity owner);
+        bool RemoveOwner(PointHandle point, entt::entity owner);
+        //points the owner no longer uses become free once nothing else uses them
+        void ReleaseControlPoints(entt::entity owner, const std::vector<PointHandle>& points);
+
+        void AddDependent(entt::entity source, entt::entity dependent);
+        void RemoveDependent(entt::entity source, entt::entity dependent);
+
+        //bumps the revision of the object and of everything built from it, the data itself is rebuilt when next asked for
+        void InvalidateDerivedData(entt::entity entity);
+        void InvalidateOwners(PointHandle point);
+        //invalidates the owners of every point that moved since the last call, runs before anything reads derived data
+        //the PointStore keeps the positions and lists the moved points, nothing is scanned when nothing moved
+        void PropagateChanges();
+
+        void AddControlPoint(const Ref<Curve>& curve, const Ref<Point>& point);
+        void RemoveControlPoint(const Ref<Curve>& curve, const Ref<Point>& point);
+
+        void RenderControlPoints(const std::vector<PointHandle>& points);
+        void RenderControlPoints(const std::vector<glm::vec3>& points);
+        void RenderControlPolygon(const std::vector<PointHandle>& points, const glm::vec4& color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
         void RenderControlPolygon(const std::vector<glm::vec3>& points, const glm::vec4& color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
 
-        void RenderControlGrid(const std::vector<Ref<Point>>& points, const std::vector<uint32_t>& gridIndices, const glm::vec4& color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+        void RenderControlGrid(const std::vector<PointHandle>& points, const std::vector<uint32_t>& gridIndices, const glm::vec4& color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
 
         void RenderTorus(Ref<Torus> torus);
         void RenderBezier(Ref<BezierC0> bezierC0);
@@ -112,28 +324,28 @@ namespace CADMageddon
         void RenderBezierPatch(Ref<BezierPatch> bezierPatch);
         void RenderBSplinePatch(Ref<BSplinePatch> bSplinePatch);
         void RenderGregoryPatch(Ref<GregoryPatch> gregoryPatch);
-        void RenderGregoryPatch(FillingData fillingData, int uDivisionCount, int vDivisionCount, bool showMesh, const glm::vec4& color);
-        void RenderGregoryPatchMesh(FillingData fillingData, const glm::vec4& color);
+        void RenderGregoryPatchMesh(const FillingData& fillingData, const glm::vec4& color);
         void RenderIntersectionCurve(Ref<IntersectionCurve> curve);
 
+
         bool AddNewPointToBezier(Ref<Point> point);
         bool AddNewPointToBSpline(Ref<Point> point);
         bool AddNewPointToInterpolated(Ref<Point> point);
 
-        void DeleteFreePoint(Ref<Point> point);
-        void DeleteTorus(Ref<Torus> torus);
-
-        void DeleteBezierC0(Ref<BezierC0> bezierC0);
-        void DeleteBSpline(Ref<BSpline> bSpline);
-        void DeleteInterpolatedCurve(Ref<InterpolatedCurve> interpolatedCurve);
-        void DeleteBezierPatch(Ref<BezierPatch> bezierPatch);
-        void DeleteGregoryPatch(Ref<GregoryPatch> gregoryPatch);
-        void DeleteBSplinePatch(Ref<BSplinePatch> bSplinePatch);
-        void DeleteIntersectionCurve(Ref<IntersectionCurve> curve);
+        void DeleteBezierPatches(const std::vector<Ref<BezierPatch>>& bezierPatches);
+        void DeleteIntersectionCurves(const std::vector<Ref<IntersectionCurve>>& curves);
 
     private:
-        std::unordered_set<Ref<BaseObject>> m_BaseObjects;
-        std::vector<Ref<Point>> m_Points; //consider change to unordered set
+        entt::registry m_Registry;
+        //objects using each point, once per object however often the point repeats in it
+        std::unordered_multimap<PointHandle, entt::entity, PointHandleHash> m_PointOwners;
+        std::vector<PointHandle> m_MovedPoints;
+        uint64_t m_PropagatedChangeCount = 0;
+        //objects built from other objects, patches lead to the Gregory patches filling the holes between them
+        std::unordered_multimap<entt::entity, entt::entity> m_Dependents;
+
+        //creation order, kept for the hierarchy and the saved file
+        std::vector<Ref<Point>> m_Points;
 
 
         std::vector<Ref<Point>> m_FreePoints;
@@ -152,6 +364,7 @@ namespace CADMageddon
 
         std::function<void(Ref<Point> p1, Ref<Point> p2, Ref<Point> p3)> m_onPointMerged;
         std::function<void(Ref<GregoryPatch>)> m_OnGregoryPatchDeleted;
+        std::function<void()> m_OnChanged;
 
 
         friend class SceneSerializer;
@@ -0,0 +1,51 @@
+#pragma once
+#include <entt.hpp>
+#include "Components.h"
+
+namespace CADMageddon
+{
+    // Link from an object to its entity in the scene registry. Objects keep their own flags
+    // and mirror them into tag components here, so the pools always match the objects.
+    // Not attached while the object is outside a scene.
+    class SceneEntity
+    {
+    public:
+        SceneEntity() = default;
+
+        //a copied object is not in the scene yet
+        SceneEntity(const SceneEntity&) {}
+        SceneEntity& operator=(const SceneEntity&) { return *this; }
+
+        void Attach(entt::registry* registry, entt::entity entity)
+        {
+            m_Registry = registry;
+            m_Entity = entity;
+        }
+
+        void Detach()
+        {
+            m_Registry = nullptr;
+            m_Entity = entt::null;
+        }
+
+        bool IsAttached() const { return m_Registry != nullptr; }
+        bool IsAttachedTo(const entt::registry& registry) const { return m_Registry == &registry; }
+        entt::entity GetHandle() const { return m_Entity; }
+
+        template<typename Tag>
+        void SetTag(bool value)
+        {
+            if (!m_Registry)
+                return;
+
+            if (value && !m_Registry->has<Tag>(m_Entity))
+                m_Registry->emplace<Tag>(m_Entity);
+            else if (!value)
+                m_Registry->remove_if_exists<Tag>(m_Entity);
+        }
+
+    private:
+        entt::registry* m_Registry = nullptr;
+        entt::entity m_Entity = entt::null;
+    };
+}
@@ -8,40 +8,47 @@ namespace CADMageddon
         SetName(name);
         RecalculateMesh();
         m_Transform = CreateRef<Transform>();
-        m_Transform->Translation = position;
+        m_Transform->SetTranslation(position);
     }
 
     void Torus::RecalculateMesh()
     {
         auto mesh = ObjectFactory::CreateTorusMesh(m_TorusParameters.MajorRadius, m_TorusParameters.MinorRadius, m_TorusParameters.MajorRadiusCount, m_TorusParameters.MinorRadiusCount);
-        m_Points.clear();
-        for (auto vertex : mesh.Vertices)
-        {
-            auto point = CreateRef<Point>(vertex, "Point");
-            point->GetTransform()->Parent = m_Transform;
-            m_Points.push_back(point);
-        }
+        m_Vertices = std::move(mesh.Vertices);
+        m_TextureCoordinates = std::move(mesh.TextureCoordinates);
+        m_Indices = std::move(mesh.Indices);
 
-        m_Indices = mesh.Indices;
+        m_LocalBoundingBox.Reset();
+        for (const auto& vertex : m_Vertices)
+            m_LocalBoundingBox.Expand(vertex);
 
-        m_TextureCoordinates.clear();
-        m_TextureCoordinates.reserve(m_Points.size());
+        UpdateVertexArray();
+        RecalculateTrimCurveGrid();
+    }
 
-        int uCount = m_TorusParameters.MajorRadiusCount;
-        int vCount = m_TorusParameters.MinorRadiusCount;
-        float uDelta = 1.0f / uCount;
-        float vDelta = 1.0f / vCount;
-        for (int i = 0; i <= uCount; i++)
+    void Torus::UpdateVertexArray()
+    {
+        std::vector<float> verticesData(m_Vertices.size() * 5);
+        for (int i = 0; i < m_Vertices.size(); i++)
         {
-            float u = i * uDelta;
-            for (int j = 0; j <= vCount; j++)
-            {
-                float v = j * vDelta;
-                m_TextureCoordinates.push_back(glm::vec2(u, v));
-            }
+            verticesData[5 * i] = m_Vertices[i].x;
+            verticesData[5 * i + 1] = m_Vertices[i].y;
+            verticesData[5 * i + 2] = m_Vertices[i].z;
+            verticesData[5 * i + 3] = m_TextureCoordinates[i].x;
+            verticesData[5 * i + 4] = m_TextureCoordinates[i].y;
         }
 
-        RecalculateTrimCurveGrid();
+        auto vertexBuffer = CreateRef<OpenGLVertexBuffer>(verticesData.data(), verticesData.size() * sizeof(float));
+        vertexBuffer->SetLayout({
+            { ShaderDataType::Float3, "a_Position" },
+            { ShaderDataType::Float2, "a_TextureCoordinates" }
+            });
+
+        auto indexBuffer = CreateRef<OpenGLIndexBuffer>(m_Indices.data(), m_Indices.size());
+
+        m_VertexArray = CreateRef<OpenGLVertexArray>();
+        m_VertexArray->AddVertexBuffer(vertexBuffer);
+        m_VertexArray->SetIndexBuffer(indexBuffer);
     }
 
     glm::vec3 Torus::GetPointAt(float u, float v)
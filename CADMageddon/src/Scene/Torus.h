@@ -4,6 +4,7 @@
 #include "Core\Base.h"
 #include "BaseObject.h"
 #include "SurfaceUV.h"
+#include "Rendering\VertexArray.h"
 
 namespace CADMageddon
 {
@@ -25,15 +26,23 @@ namespace CADMageddon
 
         TorusParameters& GetTorusParameters() { return m_TorusParameters; }
 
-        std::vector<Ref<Point>> GetPoints() { return m_Points; }
-        std::vector<uint32_t> GetIndices() { return m_Indices; }
-        std::vector<glm::vec2> GetTextureCoordinates() { return m_TextureCoordinates; }
+        const std::vector<glm::vec3>& GetVertices() const { return m_Vertices; }
+        const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+        const std::vector<glm::vec2>& GetTextureCoordinates() const { return m_TextureCoordinates; }
         Ref<Transform> GetTransform() { return m_Transform; }
+        const Ref<OpenGLVertexArray>& GetVertexArray() const { return m_VertexArray; }
+        BoundingBox GetBoundingBox() const { return m_LocalBoundingBox.Transformed(m_Transform->GetMatrix()); }
 
         void RecalculateMesh();
 
         bool GetIsSelected() { return m_IsSelected; }
-        void SetIsSelected(bool isSelected) { m_IsSelected = isSelected; }
+        void SetIsSelected(bool isSelected)
+        {
+            m_IsSelected = isSelected;
+            m_Entity.SetTag<SelectedComponent>(isSelected);
+        }
+
+        SceneEntity& GetEntity() { return m_Entity; }
 
         virtual glm::vec3 GetPointAt(float u, float v) override;
         virtual glm::vec3 GetTangentUAt(float u, float v) override;
@@ -47,16 +56,22 @@ namespace CADMageddon
         virtual int GetUDivision() const override { return m_TorusParameters.MajorRadiusCount; }
         virtual int GetVDivision() const override { return m_TorusParameters.MinorRadiusCount; }
 
+    private:
+        void UpdateVertexArray();
+
     private:
         Ref<Transform> m_Transform;
         std::string m_Name;
         TorusParameters m_TorusParameters;
 
-        std::vector<Ref<Point>> m_Points;
+        std::vector<glm::vec3> m_Vertices;
         std::vector<uint32_t> m_Indices;
         std::vector<glm::vec2> m_TextureCoordinates;
+        BoundingBox m_LocalBoundingBox;
+        Ref<OpenGLVertexArray> m_VertexArray;
 
         bool m_IsSelected = false;
+        SceneEntity m_Entity;
     };
 
 }
\ No newline at end of file
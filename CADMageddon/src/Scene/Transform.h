@@ -1,35 +1,147 @@
 #pragma once
+#include "Core\Base.h"
 #include <glm\glm.hpp>
 #include <glm\gtc\matrix_transform.hpp>
+#include <vector>
 
 namespace CADMageddon
 {
-    struct Transform
+    // Position, rotation and scale, optionally following a parent. The matrices are cached and rebuilt
+    // only after a setter changed this transform or the parent's matrix got a new version.
+    class Transform
     {
-        glm::vec3 Translation = { 0.0f,0.0f,0.0f };
-        glm::vec3 Rotation = { 0.0f,0.0f,0.0f };
-        glm::vec3 Scale = { 1.0f,1.0f,1.0f };
-        Ref<Transform> Parent = nullptr;
+    public:
+        const glm::vec3& GetTranslation() const { return m_Translation; }
+        void SetTranslation(const glm::vec3& translation)
+        {
+            if (translation == m_Translation)
+                return;
+
+            m_Translation = translation;
+            MarkChanged();
+        }
 
-        glm::mat4 GetMatrix()
+        const glm::vec3& GetRotation() const { return m_Rotation; }
+        void SetRotation(const glm::vec3& rotation)
         {
-            auto translationMatrix = glm::translate(glm::mat4(1.0f), Translation);
-            auto rotationMatrix =
-                glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.x), glm::vec3(1.0f, 0.0f, 0.0f))
-                * glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.y), glm::vec3(0.0f, 1.0f, 0.0f))
-                * glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.z), glm::vec3(0.0f, 0.0f, -1.0f));
-            auto scaleMatrix = glm::scale(glm::mat4(1.0f), Scale);
+            if (rotation == m_Rotation)
+                return;
+
+            m_Rotation = rotation;
+            MarkChanged();
+        }
+
+        const glm::vec3& GetScale() const { return m_Scale; }
+        void SetScale(const glm::vec3& scale)
+        {
+            if (scale == m_Scale)
+                return;
+
+            m_Scale = scale;
+            MarkChanged();
+        }
+
+        const Ref<Transform>& GetParent() const { return m_Parent; }
+        void SetParent(const Ref<Transform>& parent)
+        {
+            if (parent == m_Parent)
+                return;
+
+            m_Parent = parent;
+            MarkChanged();
+        }
+
+        const glm::mat4& GetMatrix()
+        {
+            Update();
+            return m_WorldMatrix;
+        }
+
+        //changes whenever the matrix does, caches built from the matrix compare it
+        uint64_t GetVersion()
+        {
+            Update();
+            return m_WorldVersion;
+        }
 
-            auto modelMatrix = translationMatrix * rotationMatrix * scaleMatrix;
+        //every setter call that changed something adds the index to the list, the PointStore hands out its slots this way
+        void SetChangeList(std::vector<uint32_t>* changeList, uint32_t index)
+        {
+            m_ChangeList = changeList;
+            m_ChangeIndex = index;
+        }
+
+        //bumped by every setter of every transform, unchanged means no matrix anywhere changed
+        static uint64_t GetChangeCount() { return s_ChangeCount; }
+
+    private:
+        void MarkChanged()
+        {
+            m_LocalVersion++;
+            s_ChangeCount++;
+            if (m_ChangeList)
+                m_ChangeList->push_back(m_ChangeIndex);
+        }
+
+        void Update()
+        {
+            //no transform anywhere changed since the last check, the parent chain is not walked
+            if (m_CheckedChangeCount == s_ChangeCount)
+                return;
 
-            if (Parent)
+            uint64_t parentVersion = m_Parent ? m_Parent->GetVersion() : 0;
+            if (m_MatrixLocalVersion != m_LocalVersion || m_MatrixParentVersion != parentVersion)
             {
-                glm::vec3 parentTranslation = Parent->GetMatrix() * glm::vec4(Translation, 1.0f);
-                parentTranslation -= Translation;
-                modelMatrix = glm::translate(glm::mat4(1.0f), parentTranslation) * modelMatrix;
+                if (m_MatrixLocalVersion != m_LocalVersion)
+                    m_LocalMatrix = CalculateLocalMatrix();
+
+                m_WorldMatrix = m_LocalMatrix;
+                if (m_Parent)
+                {
+                    glm::vec3 parentTranslation = m_Parent->GetMatrix() * glm::vec4(m_Translation, 1.0f);
+                    parentTranslation -= m_Translation;
+                    m_WorldMatrix = glm::translate(glm::mat4(1.0f), parentTranslation) * m_LocalMatrix;
+                }
+
+                m_MatrixLocalVersion = m_LocalVersion;
+                m_MatrixParentVersion = parentVersion;
+                m_WorldVersion++;
             }
 
-            return modelMatrix;
+            m_CheckedChangeCount = s_ChangeCount;
         }
+
+        glm::mat4 CalculateLocalMatrix() const
+        {
+            auto translationMatrix = glm::translate(glm::mat4(1.0f), m_Translation);
+            auto rotationMatrix =
+                glm::rotate(glm::mat4(1.0f), glm::radians(m_Rotation.x), glm::vec3(1.0f, 0.0f, 0.0f))
+                * glm::rotate(glm::mat4(1.0f), glm::radians(m_Rotation.y), glm::vec3(0.0f, 1.0f, 0.0f))
+                * glm::rotate(glm::mat4(1.0f), glm::radians(m_Rotation.z), glm::vec3(0.0f, 0.0f, -1.0f));
+            auto scaleMatrix = glm::scale(glm::mat4(1.0f), m_Scale);
+
+            return translationMatrix * rotationMatrix * scaleMatrix;
+        }
+
+    private:
+        glm::vec3 m_Translation = { 0.0f,0.0f,0.0f };
+        glm::vec3 m_Rotation = { 0.0f,0.0f,0.0f };
+        glm::vec3 m_Scale = { 1.0f,1.0f,1.0f };
+        Ref<Transform> m_Parent = nullptr;
+
+        uint64_t m_LocalVersion = 1;
+        uint64_t m_MatrixLocalVersion = 0;
+        uint64_t m_MatrixParentVersion = 0;
+        uint64_t m_WorldVersion = 0;
+        uint64_t m_CheckedChangeCount = 0;
+
+        std::vector<uint32_t>* m_ChangeList = nullptr;
+        uint32_t m_ChangeIndex = 0;
+
+        glm::mat4 m_LocalMatrix = glm::mat4(1.0f);
+        glm::mat4 m_WorldMatrix = glm::mat4(1.0f);
+
+        //bumped by every setter of every transform
+        static inline uint64_t s_ChangeCount = 1;
     };
-}
\ No newline at end of file
+}
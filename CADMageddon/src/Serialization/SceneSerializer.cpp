@@ -17,7 +17,7 @@ namespace CADMageddon
         sceneElement->SetAttribute("xmlns", "http://mini.pw.edu.pl/mg1");
 
 
-        for (auto point : scene.GetPoints())
+        for (const auto& point : scene.GetPoints())
         {
             auto pointElement = sceneElement->InsertNewChildElement("Point");
             pointElement->SetAttribute("Name", point->GetName().c_str());
@@ -28,7 +28,7 @@ namespace CADMageddon
             positionElement->SetAttribute("Z", position.z);
         }
 
-        for (auto bezierCurve : scene.GetBezierC0())
+        for (const auto& bezierCurve : scene.GetBezierC0())
         {
             auto bezierElement = sceneElement->InsertNewChildElement("BezierC0");
             bezierElement->SetAttribute("Name", bezierCurve->GetName().c_str());
@@ -38,11 +38,11 @@ namespace CADMageddon
             for (auto point : bezierCurve->GetControlPoints())
             {
                 auto pointRefElement = pointRefsElement->InsertNewChildElement("PointRef");
-                pointRefElement->SetAttribute("Name", point->GetName().c_str());
+                pointRefElement->SetAttribute("Name", PointStore::Get().GetName(point).c_str());
             }
         }
 
-        for (auto bSplineCurve : scene.GetBSpline())
+        for (const auto& bSplineCurve : scene.GetBSpline())
         {
             auto bezierElement = sceneElement->InsertNewChildElement("BezierC2");
             bezierElement->SetAttribute("Name", bSplineCurve->GetName().c_str());
@@ -52,11 +52,11 @@ namespace CADMageddon
             for (auto point : bSplineCurve->GetControlPoints())
             {
                 auto pointRefElement = pointRefsElement->InsertNewChildElement("PointRef");
-                pointRefElement->SetAttribute("Name", point->GetName().c_str());
+                pointRefElement->SetAttribute("Name", PointStore::Get().GetName(point).c_str());
             }
         }
 
-        for (auto interpolated : scene.GetInterpolated())
+        for (const auto& interpolated : scene.GetInterpolated())
         {
             auto bezierElement = sceneElement->InsertNewChildElement("BezierInter");
             bezierElement->SetAttribute("Name", interpolated->GetName().c_str());
@@ -66,11 +66,11 @@ namespace CADMageddon
             for (auto point : interpolated->GetControlPoints())
             {
                 auto pointRefElement = pointRefsElement->InsertNewChildElement("PointRef");
-                pointRefElement->SetAttribute("Name", point->GetName().c_str());
+                pointRefElement->SetAttribute("Name", PointStore::Get().GetName(point).c_str());
             }
         }
 
-        for (auto torus : scene.GetTorus())
+        for (const auto& torus : scene.GetTorus())
         {
             auto torusElement = sceneElement->InsertNewChildElement("Torus");
             torusElement->SetAttribute("Name", torus->GetName().c_str());
@@ -84,8 +84,8 @@ namespace CADMageddon
             torusElement->SetAttribute("HorizontalSlices", torusParameters.MinorRadiusCount);
 
             auto torusPosition = torus->GetTransform()->GetMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-            auto torusRotation = torus->GetTransform()->Rotation;
-            auto torusScale = torus->GetTransform()->Scale;
+            auto torusRotation = torus->GetTransform()->GetRotation();
+            auto torusScale = torus->GetTransform()->GetScale();
 
             auto positionElement = torusElement->InsertNewChildElement("Position");
             positionElement->SetAttribute("X", torusPosition.x);
@@ -103,7 +103,7 @@ namespace CADMageddon
             scaleElement->SetAttribute("Z", torusScale.z);
         }
 
-        for (auto bezierPatch : scene.GetBezierPatch())
+        for (const auto& bezierPatch : scene.GetBezierPatch())
         {
             auto bezierPatchElement = sceneElement->InsertNewChildElement("PatchC0");
             bezierPatchElement->SetAttribute("Name", bezierPatch->GetName().c_str());
@@ -119,17 +119,17 @@ namespace CADMageddon
             else
                 verticesCountX = bezierPatch->GetPatchCountX() * 3 + 1;
 
-            auto points = bezierPatch->GetControlPoints();
+            const auto& points = bezierPatch->GetControlPoints();
             for (int i = 0; i < points.size(); i++)
             {
                 auto pointRefElement = pointRefsElement->InsertNewChildElement("PointRef");
-                pointRefElement->SetAttribute("Name", points[i]->GetName().c_str());
+                pointRefElement->SetAttribute("Name", PointStore::Get().GetName(points[i]).c_str());
                 pointRefElement->SetAttribute("Row", i / verticesCountX);
                 pointRefElement->SetAttribute("Column", i % verticesCountX);
             }
         }
 
-        for (auto bSplinePatch : scene.GetBSplinePatch())
+        for (const auto& bSplinePatch : scene.GetBSplinePatch())
         {
             auto bezierPatchElement = sceneElement->InsertNewChildElement("PatchC2");
             bezierPatchElement->SetAttribute("Name", bSplinePatch->GetName().c_str());
@@ -145,11 +145,11 @@ namespace CADMageddon
             else
                 verticesCountX = bSplinePatch->GetPatchCountX() + 3;
 
-            auto points = bSplinePatch->GetControlPoints();
+            const auto& points = bSplinePatch->GetControlPoints();
             for (int i = 0; i < points.size(); i++)
             {
                 auto pointRefElement = pointRefsElement->InsertNewChildElement("PointRef");
-                pointRefElement->SetAttribute("Name", points[i]->GetName().c_str());
+                pointRefElement->SetAttribute("Name", PointStore::Get().GetName(points[i]).c_str());
                 pointRefElement->SetAttribute("Row", i / verticesCountX);
                 pointRefElement->SetAttribute("Column", i % verticesCountX);
             }
@@ -219,7 +219,7 @@ namespace CADMageddon
             std::string name = elem->Attribute("Name");
             glm::vec3 pos = ReadVector(elem->FirstChildElement("Position"));
             auto point = CreateRef<Point>(pos, name);
-            scene.m_Points.push_back(point);
+            scene.Add(point);
             m_NotAssignedPoints.insert({ name,point });
             m_Points.insert({ name,point });
         }
@@ -239,11 +239,11 @@ namespace CADMageddon
 
         auto torus = CreateRef<Torus>(position, name);
         torus->GetTorusParameters() = torusParameters;
-        torus->GetTransform()->Rotation = rotation;
-        torus->GetTransform()->Scale = scale;
+        torus->GetTransform()->SetRotation(rotation);
+        torus->GetTransform()->SetScale(scale);
 
         torus->RecalculateMesh();
-        scene.m_Torus.push_back(torus);
+        scene.Add(torus);
     }
 
     void SceneSerializer::LoadBezierC0(Scene& scene, tinyxml2::XMLElement* bezierC0Element)
@@ -255,10 +255,10 @@ namespace CADMageddon
         {
             std::string pointName = elem->Attribute("Name");
             auto point = FindPointByName(pointName);
-            bezierC0->AddControlPoint(point);
+            bezierC0->AddControlPoint(point->GetHandle());
         }
 
-        scene.m_BezierC0.push_back(bezierC0);
+        scene.Add(bezierC0);
     }
 
     void SceneSerializer::LoadBSpline(Scene& scene, tinyxml2::XMLElement* bSplineElement)
@@ -270,10 +270,10 @@ namespace CADMageddon
         {
             std::string pointName = elem->Attribute("Name");
             auto point = FindPointByName(pointName);
-            bSpline->AddControlPoint(point);
+            bSpline->AddControlPoint(point->GetHandle());
         }
 
-        scene.m_BSpline.push_back(bSpline);
+        scene.Add(bSpline);
     }
 
     void SceneSerializer::LoadInterpolatedCurve(Scene& scene, tinyxml2::XMLElement* interpolatedCurveElement)
@@ -285,10 +285,10 @@ namespace CADMageddon
         {
             std::string pointName = elem->Attribute("Name");
             auto point = FindPointByName(pointName);
-            interpolated->AddControlPoint(point);
+            interpolated->AddControlPoint(point->GetHandle());
         }
 
-        scene.m_InterpolatedCurve.push_back(interpolated);
+        scene.Add(interpolated);
     }
 
     void SceneSerializer::LoadBezierPatch(Scene& scene, tinyxml2::XMLElement* bezierPatchElement)
@@ -300,7 +300,7 @@ namespace CADMageddon
         int uDivisionCount = bezierPatchElement->IntAttribute("ColumnSlices");
         int vDivisionCount = bezierPatchElement->IntAttribute("RowSlices");
 
-        std::vector<Ref<Point>> controlPoints;
+        std::vector<PointHandle> controlPoints;
 
         auto pointRefsElement = bezierPatchElement->FirstChildElement();
         int rowCount = 0;
@@ -321,11 +321,10 @@ namespace CADMageddon
             int Row = elem->IntAttribute("Row");
             int Column = elem->IntAttribute("Column");
             auto point = FindPointByName(elem->Attribute("Name"));
-            point->SetReferencedCount(1);
             if (isRowWrapDirection)
-                controlPoints[Column * rowCount + Row] = point;
+                controlPoints[Column * rowCount + Row] = point->GetHandle();
             else
-                controlPoints[Row * columnCount + Column] = point;
+                controlPoints[Row * columnCount + Column] = point->GetHandle();
         }
 
         auto bezierPatch = BezierPatch::CreateBezierPatch(
@@ -338,7 +337,7 @@ namespace CADMageddon
             isCylinder,
             showPolygon);
 
-        scene.m_BezierPatch.push_back(bezierPatch);
+        scene.Add(bezierPatch);
     }
 
     void SceneSerializer::LoadBSplinePatch(Scene& scene, tinyxml2::XMLElement* bSplinePatchElement)
@@ -350,7 +349,7 @@ namespace CADMageddon
         int uDivisionCount = bSplinePatchElement->IntAttribute("ColumnSlices");
         int vDivisionCount = bSplinePatchElement->IntAttribute("RowSlices");
 
-        std::vector<Ref<Point>> controlPoints;
+        std::vector<PointHandle> controlPoints;
         auto pointRefsElement = bSplinePatchElement->FirstChildElement();
         int rowCount = 0;
         int columnCount = 0;
@@ -369,11 +368,10 @@ namespace CADMageddon
             int Row = elem->IntAttribute("Row");
             int Column = elem->IntAttribute("Column");
             auto point = FindPointByName(elem->Attribute("Name"));
-            point->SetReferencedCount(1);
             if (isRowWrapDirection)
-                controlPoints[Column * rowCount + Row] = point;
+                controlPoints[Column * rowCount + Row] = point->GetHandle();
             else
-                controlPoints[Row * columnCount + Column] = point;
+                controlPoints[Row * columnCount + Column] = point->GetHandle();
         }
 
         auto bSplinePatch = BSplinePatch::CreateBSplinePatch(
@@ -386,7 +384,7 @@ namespace CADMageddon
             isCylinder,
             showPolygon);
 
-        scene.m_BSplinePatch.push_back(bSplinePatch);
+        scene.Add(bSplinePatch);
     }
 
     glm::vec3 SceneSerializer::ReadVector(tinyxml2::XMLElement* Pos)